@@ -0,0 +1,148 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Regression gate, run by the 'bench_all' target: runs day01..day09 in benchmark
+ * mode, collects their records (see aoc::record) and compares them to a baseline.
+ *      bench_compare <dir of the days> <baseline.jsonl> [threshold %] [runs] [--update]
+ * A baseline belongs to the inputs and the machine it was taken on, so it is not in
+ * the repo: if the file does not exist (or with --update), it is written from this
+ * run. Otherwise it fails if a day fails, has other answers than in the baseline, or
+ * is more than threshold percent slower (by the minimum time); differences below
+ * 0.1 ms are taken as noise. A day with another input (size) than in the baseline,
+ * or not in the baseline at all, cannot be compared and fails, too. Days without an
+ * input file (the inputs are not in the repo) are skipped, but not all of them.
+ */
+
+#include "aoc.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <set>
+
+namespace {
+    constexpr auto recordFile = "bench_all.jsonl";
+    constexpr double noiseMs = 0.1;
+
+    struct Record {
+        int day{0};
+        int64_t part1{0};
+        int64_t part2{0};
+        double ms{0};
+        size_t inputBytes{0};           // 0 if unknown
+        string line;
+    };
+
+    // just enough JSON for our own records: the value after "key":
+    template <typename T>
+    T field(const string_view line, const string_view key) {
+        const auto pattern = format("\"{}\":", key);
+        const auto pos = line.find(pattern);
+        if (pos == string_view::npos)
+            throw std::runtime_error(format("no '{}' in: {}", key, line));
+        const auto value = line.substr(pos + pattern.size());
+        return aoc::to_number<T>(value.substr(0, value.find_first_of(",}")));
+    }
+
+    std::map<int, Record> readRecords(const string& path) {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error(format("cannot open '{}'", path));
+
+        std::map<int, Record> records;
+        for (string line; std::getline(in, line); ) {
+            if (aoc::trim(line).empty()) continue;
+            Record r{field<int>(line, "day"), field<int64_t>(line, "part1"), field<int64_t>(line, "part2"),
+                     field<double>(line, "ms"), 0, line};
+            if (line.contains("\"input_bytes\":"))
+                r.inputBytes = field<size_t>(line, "input_bytes");
+            records[r.day] = std::move(r);          // the last one of a day counts
+        }
+        return records;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    if (argc < 3) {
+        println("usage: {} <dir of the days> <baseline.jsonl> [threshold %] [runs] [--update]", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const string dir = argv[1];
+    const string baselinePath = argv[2];
+    const double threshold = (argc > 3) ? aoc::to_number<double>(argv[3]) : 20.0;
+    const size_t runs = (argc > 4) ? aoc::to_number<size_t>(argv[4]) : 20;
+    const bool update = (argc > 5) && string_view(argv[5]) == "--update";
+
+    std::remove(recordFile);
+    std::set<int> skipped, failed;
+    for (int day = 1; day <= 9; ++day) {
+        if (!std::filesystem::exists(aoc::path_of(day))) {
+            println("day {:02}: skipped, no input '{}'", day, aoc::path_of(day));
+            skipped.insert(day);
+            continue;
+        }
+        const auto command = format("AOC_BENCH={} AOC_RECORD={} {}/day{:02} > /dev/null", runs, recordFile, dir, day);
+        if (std::system(command.c_str()) != 0) {
+            println("day {:02}: failed", day);
+            failed.insert(day);
+        }
+    }
+    if (skipped.size() == 9) {
+        println("-> failed, no inputs found, nothing to compare");
+        return EXIT_FAILURE;
+    }
+    const auto current = std::filesystem::exists(recordFile) ? readRecords(recordFile) : std::map<int, Record>{};
+
+    if (update || !std::filesystem::exists(baselinePath)) {
+        if (!failed.empty()) {
+            println("-> failed, no baseline from a run with failed days");
+            return EXIT_FAILURE;
+        }
+        std::ofstream out(baselinePath);
+        for (const auto& r : current | std::views::values)
+            out << r.line << '\n';
+        println("-> baseline '{}' {} with {} days", baselinePath, update ? "updated" : "created", current.size());
+        return EXIT_SUCCESS;
+    }
+
+    const auto baseline = readRecords(baselinePath);
+    bool ok = true;
+    println("day  baseline ms   current ms   change");
+    for (const auto& [day, now] : current) {
+        if (!baseline.contains(day)) {
+            println("{:02}             -  {:11.2f}   NOT COMPARABLE, not in the baseline", day, now.ms);
+            ok = false;
+        }
+    }
+    for (const auto& [day, base] : baseline) {
+        if (skipped.contains(day)) {
+            println("{:02}   {:11.2f}            -   skipped, no input", day, base.ms);
+            continue;
+        }
+        const auto it = current.find(day);
+        if (it == current.end()) {
+            println("{:02}   {:11.2f}            -   {}", day, base.ms, failed.contains(day) ? "FAILED" : "MISSING");
+            ok = false;
+            continue;
+        }
+        const auto& now = it->second;
+        if (base.inputBytes != now.inputBytes) {
+            println("{:02}   {:11.2f}  {:11.2f}   NOT COMPARABLE, other input ({} bytes, baseline {})",
+                    day, base.ms, now.ms, now.inputBytes, base.inputBytes);
+            ok = false;
+            continue;
+        }
+        const double change = (base.ms > 0) ? (now.ms / base.ms - 1.0) * 100.0 : 0.0;
+        const bool slower = change > threshold && now.ms - base.ms > noiseMs;
+        const bool wrong = now.part1 != base.part1 || now.part2 != base.part2;
+        println("{:02}   {:11.2f}  {:11.2f}  {:+6.1f}%{}{}", day, base.ms, now.ms, change,
+                slower ? "  REGRESSION" : "", wrong ? "  WRONG ANSWER" : "");
+        ok = ok && !slower && !wrong;
+    }
+    println("-> {} (threshold {}%){}", ok ? "ok" : "failed", threshold,
+            ok ? "" : format(", after an intended change: --update, see '{}'", baselinePath));
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Hash container benchmark: std::unordered_set/map against aoc::FlatSet/FlatMap
+ * with RC keys, on the access patterns of two days
+ *  - day04: collect the '@' cells of a grid into a set, then round by round filter
+ *    the cells with < 4 neighbors in the set (8 lookups each) and erase them,
+ *  - day09: for all pairs of polygon points, look up the 4 rectangle corners in a
+ *    cache, insert on a miss.
+ *      bench_flat [grid size] [points]
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    template <typename Set>
+    int64_t erodeGrid(const aoc::Field<char>& field) {
+        auto cells = std::ranges::to<Set>(
+            positions(field) | std::views::filter([&](const aoc::RC rc) { return field[rc] == '@'; }));
+
+        int64_t lifted = 0;
+        for (size_t loop = 0; loop < 1000; ++loop) {
+            auto toLift = std::ranges::to<Set>(cells | std::views::filter([&](const aoc::RC rc) {
+                return std::ranges::count_if(aoc::MooreNeighborhood::offsets,
+                                             [&](const aoc::RC o) { return cells.contains(rc + o); }) < 4;
+            }));
+            if (toLift.empty()) break;
+            lifted += static_cast<int64_t>(toLift.size());
+            for (const auto rc : toLift) cells.erase(rc);
+        }
+        return lifted;
+    }
+
+    template <typename Map>
+    int64_t cacheCorners(const std::vector<aoc::RC>& points) {
+        Map cache;
+        cache.reserve(points.size() * points.size() / 2);
+        auto lookup = [&](const aoc::RC rc) {
+            if (const auto it = cache.find(rc); it != cache.end()) return (*it).second;
+            const bool value = ((rc.row ^ rc.col) & 1) != 0;      // stands for the point-in-polygon test
+            cache.try_emplace(rc, value);
+            return value;
+        };
+
+        int64_t inside = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            for (size_t j = i + 1; j < points.size(); ++j) {
+                const auto [r1, c1] = points[i];
+                const auto [r2, c2] = points[j];
+                inside += lookup({r1, c1}) + lookup({r1, c2}) + lookup({r2, c2}) + lookup({r2, c1});
+            }
+        }
+        return inside;
+    }
+
+    template <typename F>
+    void compare(const string& name, F&& stdVersion, F&& flatVersion) {
+        auto [expected, stdTiming] = aoc::measure(stdVersion);
+        auto [result, flatTiming] = aoc::measure(flatVersion);
+        if (result != expected)
+            throw std::runtime_error("results differ");
+        println("{}: std {:.2f} ms, flat {:.2f} ms, speedup {:.2f}",
+                name, stdTiming.ms, flatTiming.ms, stdTiming.ms / flatTiming.ms);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const auto size = (argc > 1) ? aoc::to_number<aoc::index_t>(argv[1]) : 500;
+    const auto pointCount = (argc > 2) ? aoc::to_number<size_t>(argv[2]) : 500;
+
+    bench::Random random;
+    aoc::Field<char> field(size, size);
+    for (aoc::index_t row = 0; row < size; ++row)
+        for (aoc::index_t col = 0; col < size; ++col)
+            field[row, col] = (random() % 10 < 6) ? '@' : '.';
+
+    std::vector<aoc::RC> points;
+    for (size_t i = 0; i < pointCount; ++i)
+        points.push_back({random.below<aoc::index_t>(100000), random.below<aoc::index_t>(100000)});
+
+    using Run = std::function<int64_t()>;
+    compare(format("day04-like, {}x{} grid", size, size),
+            Run([&] { return erodeGrid<std::unordered_set<aoc::RC>>(field); }),
+            Run([&] { return erodeGrid<aoc::FlatSet<aoc::RC>>(field); }));
+    compare(format("day09-like, {} points", pointCount),
+            Run([&] { return cacheCorners<std::unordered_map<aoc::RC, bool>>(points); }),
+            Run([&] { return cacheCorners<aoc::FlatMap<aoc::RC, bool>>(points); }));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Generation benchmark: the day04 rule (a paper with < 4 neighbors is lifted) on a
+ * random n x n field for a fixed number of generations, repeated stencil passes
+ * against par_generations with 1, 2, 4, ... threads up to max threads.
+ *      bench_generations [size] [generations] [max threads]
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    constexpr auto lift = [](const char c, const auto& neighbors) {
+        return (c == '@' && std::ranges::count(neighbors, '@') < 4) ? '.' : c;
+    };
+
+    int64_t papers(const aoc::Field<char>& field) {
+        int64_t count = 0;
+        aoc::for_each_cell(field, [&](const char c) { count += (c == '@'); });
+        return count;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const auto size = (argc > 1) ? aoc::to_number<aoc::index_t>(argv[1]) : 10'000;
+    const auto generations = (argc > 2) ? aoc::to_number<size_t>(argv[2]) : 10;
+    const size_t maxThreads = (argc > 3) ? aoc::to_number<size_t>(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    bench::Random random;
+    aoc::Field<char> field(size, size, 1, '.');
+    for (aoc::index_t row = 0; row < size; ++row)
+        for (aoc::index_t col = 0; col < size; ++col)
+            field[row, col] = (random() % 10 < 7) ? '@' : '.';
+    println("{}x{}, {} generations, {} hardware threads", size, size, generations, std::thread::hardware_concurrency());
+
+    auto [expected, seq] = aoc::measure([&] {
+        auto f = field;
+        for (size_t g = 0; g < generations; ++g)
+            f = aoc::stencil<aoc::MooreNeighborhood>(f, lift);
+        return papers(f);
+    });
+    println("-> stencil     {:9.2f} ms", seq.ms);
+
+    bench::scaling(maxThreads, expected, seq.ms, [&](const size_t threads) {
+        auto f = field;
+        aoc::par_generations<aoc::MooreNeighborhood>(f, lift, generations, threads);
+        return papers(f);
+    });
+
+    return EXIT_SUCCESS;
+}
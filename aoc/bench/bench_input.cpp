@@ -0,0 +1,79 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Loading benchmark: Input::Storage::Owned (ifstream -> ostringstream -> string)
+ * against Input::Storage::Mapped (mmap, views into the pages) and the chunked
+ * LineStream (constant memory).
+ *
+ * Peak RSS is per process, so run one mode per call, e.g.
+ *      bench_input owned
+ *      bench_input mapped
+ *      bench_input stream
+ * A synthetic day01-like file of about 160 MB is written to 'bench_input.txt' if no
+ * file is given and it does not exist yet.
+ */
+
+#include "aoc.hpp"
+
+namespace {
+    constexpr auto syntheticFile = "bench_input.txt";
+    constexpr size_t syntheticLines = 32 * 1024 * 1024;    // 'L123\n', ~5 bytes per line
+
+    void writeSyntheticFile(const string& path) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("cannot write file");
+
+        string line;
+        for (size_t i = 0; i < syntheticLines; ++i) {
+            line = format("{}{}\n", (i % 3 == 0) ? 'L' : 'R', (i * 7919) % 1000);
+            out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        }
+    }
+
+    // walk all lines once, as every solver does
+    std::pair<size_t, size_t> countLines(std::ranges::input_range auto&& lines) {
+        size_t count = 0, chars = 0;
+        for (const string_view line : lines) { ++count; chars += line.size(); }
+        return {count, chars};
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const string mode = (argc > 1) ? argv[1] : "mapped";
+    const string path = (argc > 2) ? argv[2] : syntheticFile;
+    if (mode != "owned" && mode != "mapped" && mode != "stream") {
+        println("usage: {} [owned|mapped|stream] [file]", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (argc <= 2 && !std::ifstream(path)) {
+        println("writing synthetic input '{}'...", path);
+        writeSyntheticFile(path);
+    }
+
+    double msLoad = 0;
+    std::pair<size_t, size_t> lines;
+    double msScan = 0;
+    if (mode == "stream") {
+        auto [counted, timing] = aoc::measure([&] { return countLines(aoc::LineStream(path)); });
+        lines = counted;
+        msScan = timing.ms;
+    } else {
+        const auto storage = (mode == "owned") ? aoc::Input::Storage::Owned : aoc::Input::Storage::Mapped;
+        auto [input, loadTiming] = aoc::measure([&] { return aoc::Input::from_file(path, storage); });
+        msLoad = loadTiming.ms;
+        auto [counted, scanTiming] = aoc::measure([&] { return countLines(input | aoc::as_line_views); });
+        lines = counted;
+        msScan = scanTiming.ms;
+    }
+
+    const size_t bytes = lines.first + lines.second - 1;     // chars + '\n's
+    const auto ms = msLoad + msScan;
+    println("{}: {} bytes, {} lines", mode, bytes, lines.first);
+    println("-> load {:.2f} ms, scan {:.2f} ms, total {:.2f} ms, {:.2f} GB/s",
+            msLoad, msScan, ms, static_cast<double>(bytes) / ms / 1e6);
+    println("-> peak rss {:.1f} MiB", static_cast<double>(aoc::peak_rss_kib()) / 1024.0);
+
+    return EXIT_SUCCESS;
+}
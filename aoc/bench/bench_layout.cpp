@@ -0,0 +1,92 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Field layout benchmark: the same workloads on RowMajor, Tiled<16> and Morton
+ * fields of n x n cells, for n = 100, 1000, ... up to max size
+ *  - stencil: Moore neighbor counts of a char field with border (day04-like),
+ *  - column sweep: top-down, column by column, each cell from the one above it
+ *    (day07-like beams),
+ *  - random access: reads at 10^6 random positions.
+ *      bench_layout [max size]
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    constexpr size_t randomReads = 1'000'000;
+
+    template <typename Layout>
+    int64_t stencilCounts(const aoc::Field<char, Layout>& field) {
+        const auto counts = aoc::stencil<aoc::MooreNeighborhood>(field, [](char, const auto& nb) {
+            return static_cast<uint8_t>(std::ranges::count(nb, '@'));
+        });
+        int64_t sum = 0;
+        aoc::for_each_cell(counts, [&](const uint8_t n) { sum += n; });
+        return sum;
+    }
+
+    template <typename Layout>
+    int64_t columnSweep(aoc::Field<int32_t, Layout>& field) {
+        for (aoc::index_t col = 0; col < field.cols(); ++col)
+            for (aoc::index_t row = 1; row < field.rows(); ++row)
+                field[row, col] = (field[row - 1, col] + field[row, col]) & 0xffff;
+        int64_t sum = 0;
+        for (aoc::index_t col = 0; col < field.cols(); ++col)
+            sum += field[field.rows() - 1, col];
+        return sum;
+    }
+
+    template <typename Layout>
+    int64_t randomAccess(const aoc::Field<char, Layout>& field, const std::vector<aoc::RC>& positions) {
+        int64_t sum = 0;
+        for (const auto rc : positions) sum += field[rc];
+        return sum;
+    }
+
+    template <typename Layout>
+    void run(const string& name, const aoc::Field<char>& chars, const aoc::Field<int32_t>& ints,
+             const std::vector<aoc::RC>& positions, const std::array<int64_t, 3>& expected) {
+        const aoc::Field<char, Layout> field(chars);
+        const aoc::Field<int32_t, Layout> numbers(ints);
+
+        auto [counts, stencilTiming] = aoc::measure([&] { return stencilCounts(field); });
+        auto [sweep, sweepTiming] = aoc::measure([&] { auto copy = numbers; return columnSweep(copy); });
+        auto [reads, randomTiming] = aoc::measure([&] { return randomAccess(field, positions); });
+        if (std::array{counts, sweep, reads} != expected)
+            throw std::runtime_error(format("{}: results differ", name));
+        println("  {:10} stencil {:9.2f} ms, column sweep {:9.2f} ms, random access {:9.2f} ms",
+                name, stencilTiming.ms, sweepTiming.ms, randomTiming.ms);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const auto maxSize = (argc > 1) ? aoc::to_number<aoc::index_t>(argv[1]) : 10'000;
+
+    for (aoc::index_t size = 100; size <= maxSize; size *= 10) {
+        bench::Random random;
+        aoc::Field<char> chars(size, size, 1, '.');
+        aoc::Field<int32_t> ints(size, size);
+        for (aoc::index_t row = 0; row < size; ++row) {
+            for (aoc::index_t col = 0; col < size; ++col) {
+                chars[row, col] = (random() % 10 < 6) ? '@' : '.';
+                ints[row, col] = random.below<int32_t>(1000);
+            }
+        }
+        std::vector<aoc::RC> positions(randomReads);
+        for (auto& rc : positions)
+            rc = {random.below(size), random.below(size)};
+
+        auto copy = ints;
+        const std::array expected{stencilCounts(chars), columnSweep(copy), randomAccess(chars, positions)};
+
+        println("{}x{}", size, size);
+        run<aoc::RowMajor>("row-major", chars, ints, positions, expected);
+        run<aoc::Tiled<16>>("tiled 16", chars, ints, positions, expected);
+        run<aoc::Morton>("morton", chars, ints, positions, expected);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,55 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * All-pairs benchmark (day08-like): for n random points, all n(n-1)/2 pairs sorted by
+ * distance, as a double loop plus std::ranges::sort against aoc::sorted_pairs (blocks
+ * of the pair triangle, radix sort) on pools of 1, 2, 4, ... threads.
+ *      bench_pairs [max points] [max threads]
+ * n goes 1000, 2000, 5000, 10000, 20000 up to max points (default 10000, as 20000
+ * points are 200M pairs, 3.2 GB, twice for the sort).
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    std::vector<aoc::PointPair> sortedBySort(const std::vector<aoc::Point3>& points) {
+        std::vector<aoc::PointPair> pairs;
+        pairs.reserve(points.size() * (points.size() - 1) / 2);
+        for (uint32_t i = 0; i < points.size(); ++i)
+            for (uint32_t j = i + 1; j < points.size(); ++j)
+                pairs.push_back({i, j, aoc::dist2(points[i], points[j])});
+        std::ranges::sort(pairs);
+        return pairs;
+    }
+
+    // order and content in one number
+    int64_t checksum(const std::vector<aoc::PointPair>& pairs) {
+        int64_t sum = 0;
+        for (size_t k = 0; k < pairs.size(); k += 997)
+            sum += static_cast<int64_t>(k) * (pairs[k].i + 3 * pairs[k].j) + pairs[k].dist;
+        return sum;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const size_t maxPoints = (argc > 1) ? aoc::to_number<size_t>(argv[1]) : 10'000;
+    const size_t maxThreads = (argc > 2) ? aoc::to_number<size_t>(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    println("{} hardware threads", std::thread::hardware_concurrency());
+
+    for (const size_t n : {1'000, 2'000, 5'000, 10'000, 20'000}) {
+        if (n > maxPoints) break;
+        const auto points = bench::random_points(n, 100'000);
+
+        auto [expected, seq] = aoc::measure([&] { return checksum(sortedBySort(points)); });
+        println("{} points, {} pairs: loop + sort {:9.2f} ms", n, n * (n - 1) / 2, seq.ms);
+
+        bench::scaling(maxThreads, expected, seq.ms, [&](aoc::ThreadPool& pool) {
+            return checksum(aoc::sorted_pairs(points, pool));
+        });
+    }
+
+    return EXIT_SUCCESS;
+}
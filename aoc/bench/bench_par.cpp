@@ -0,0 +1,67 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Parallel fold benchmark: a day03-like per-line computation over 10^7 synthetic
+ * lines, sequential loop against par_transform_reduce on pools of 1, 2, 4, ...
+ * threads up to the hardware concurrency.
+ *      bench_par [lines] [max threads]
+ * The input is generated in memory, so only the fold itself is measured.
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    constexpr size_t defaultLines = 10'000'000;
+    constexpr size_t lineLength = 15;                       // as in the day03 example
+
+    string syntheticText(const size_t lines) {
+        string text;
+        text.reserve(lines * (lineLength + 1));
+        bench::Random random;
+        for (size_t i = 0; i < lines; ++i) {
+            for (size_t j = 0; j < lineLength; ++j)
+                text.push_back(static_cast<char>('1' + random() % 9));
+            text.push_back('\n');
+        }
+        return text;
+    }
+
+    // same as day03
+    int64_t joltage(const string_view line, const size_t digits) {
+        size_t pos{0};
+        int64_t result{0};
+        for (size_t j = 1; j <= digits; ++j) {
+            const auto it = std::ranges::max_element(line.begin() + pos, line.begin() + (line.size() - (digits - j)));
+            result = result * 10 + (*it - '0');
+            pos = std::distance(line.begin(), it) + 1;
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const size_t lineCount = (argc > 1) ? aoc::to_number<size_t>(argv[1]) : defaultLines;
+    const auto input = aoc::Input::of(syntheticText(lineCount));
+    const auto lines = input | aoc::as_std_lines;
+    println("{} lines, {} hardware threads", lines.size(), std::thread::hardware_concurrency());
+
+    auto map = [](const string_view line) { return joltage(line, 12); };
+
+    auto [expected, seq] = aoc::measure([&] {
+        int64_t sum = 0;
+        for (const string_view line : lines) sum += map(line);
+        return sum;
+    });
+    const double msSeq = seq.ms;
+    println("-> sequential  {:9.2f} ms", msSeq);
+
+    const size_t maxThreads = (argc > 2) ? aoc::to_number<size_t>(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    bench::scaling(maxThreads, expected, msSeq, [&](aoc::ThreadPool& pool) {
+        return aoc::par_transform_reduce(lines, int64_t{0}, std::plus{}, map, pool);
+    });
+
+    return EXIT_SUCCESS;
+}
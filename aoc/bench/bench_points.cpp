@@ -0,0 +1,63 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+/*
+ * Squared-distance kernel benchmark (day08-like): the distances of all pairs, row by
+ * row (point i to i+1..n-1), as the scalar loop over Point3 structs against the
+ * aoc::Points3 kernel, in double lanes (coordinates up to 2^24, as in day08) and in
+ * 64-bit integer lanes (larger coordinates), reported in pairs per second.
+ *      bench_points [points] [runs]
+ */
+
+#include "aoc.hpp"
+#include "bench_util.hpp"
+
+namespace {
+    // the best of some runs of kernel(i, out) for all rows, the sum of all distances as check
+    template <typename Kernel>
+    std::pair<int64_t, double> rows(const size_t n, const size_t runs, Kernel&& kernel) {
+        std::vector<int64_t> out(n);
+        int64_t sum = 0;
+        double best = std::numeric_limits<double>::max();
+        for (size_t run = 0; run < runs; ++run) {
+            auto [s, timing] = aoc::measure([&] {
+                int64_t rowSum = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    kernel(i, std::span(out).first(n - i - 1));
+                    for (size_t k = 0; k < n - i - 1; ++k) rowSum += out[k];
+                }
+                return rowSum;
+            });
+            sum = s;
+            best = std::min(best, timing.ms);
+        }
+        return {sum, best};
+    }
+}
+
+int main(int argc, char* argv[]) {
+    println("\n--- {} ---\n", __FILE__);
+
+    const size_t n = (argc > 1) ? aoc::to_number<size_t>(argv[1]) : 10'000;
+    const size_t runs = (argc > 2) ? aoc::to_number<size_t>(argv[2]) : 5;
+    const double pairs = static_cast<double>(n) * static_cast<double>(n - 1) / 2;
+    println("{} points, {} pairs, best of {} runs", n, n * (n - 1) / 2, runs);
+
+    for (const int64_t range : {int64_t{100'000}, int64_t{1} << 30}) {
+        const auto points = bench::random_points(n, range);
+        const aoc::Points3 soa(points);
+
+        auto [expected, scalar] = rows(n, runs, [&](const size_t i, std::span<int64_t> out) {
+            for (size_t j = i + 1; j < n; ++j)
+                out[j - i - 1] = aoc::dist2(points[i], points[j]);
+        });
+        auto [sum, simd] = rows(n, runs, [&](const size_t i, std::span<int64_t> out) { soa.distances_from(i, out); });
+        if (sum != expected)
+            throw std::runtime_error("kernel result differs");
+
+        println("coordinates < {}, {} lanes", range, soa.double_lanes() ? "double" : "int64");
+        println("-> scalar   {:8.2f} ms, {:7.1f} M pairs/s", scalar, pairs / scalar / 1e3);
+        println("-> Points3  {:8.2f} ms, {:7.1f} M pairs/s, speedup {:.2f}", simd, pairs / simd / 1e3, scalar / simd);
+    }
+
+    return EXIT_SUCCESS;
+}
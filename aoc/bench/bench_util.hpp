@@ -0,0 +1,59 @@
+// (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_BENCH_UTIL
+#define AOC_BENCH_UTIL
+
+#include "aoc.hpp"
+
+namespace bench {
+
+    // xorshift64 with a fixed seed, so all runs (and all benches) see the same data
+    class Random {
+        uint64_t state_{88172645463325252ull};
+
+    public:
+        uint64_t operator()() noexcept {
+            state_ ^= state_ << 13; state_ ^= state_ >> 7; state_ ^= state_ << 17;
+            return state_;
+        }
+
+        // in [0, n)
+        template <std::integral T>
+        T below(const T n) noexcept { return static_cast<T>((*this)() % static_cast<uint64_t>(n)); }
+    };
+
+    // n points with coordinates in [0, range), e.g. day08-like boxes
+    inline std::vector<aoc::Point3> random_points(const size_t n, const int64_t range) {
+        Random random;
+        std::vector<aoc::Point3> points(n);
+        for (auto& p : points)
+            p = {random.below(range), random.below(range), random.below(range)};
+        return points;
+    }
+
+    /*
+     * The scaling loop of the parallel benches: the workload on 1, 2, 4, ... threads up
+     * to max threads, each result checked against the sequential one, with time and
+     * speedup. The workload takes a pool of that size (set up outside the measurement)
+     * or, if it cannot, the thread count itself.
+     */
+    template <typename T, typename Workload>
+    void scaling(const size_t maxThreads, const T& expected, const double seqMs, Workload&& workload) {
+        for (size_t threads = 1; ; threads = std::min(2 * threads, maxThreads)) {
+            auto [result, timing] = [&] {
+                if constexpr (std::invocable<Workload&, aoc::ThreadPool&>) {
+                    aoc::ThreadPool pool(threads);
+                    return aoc::measure([&] { return workload(pool); });
+                } else {
+                    return aoc::measure([&] { return workload(threads); });
+                }
+            }();
+            if (result != expected)
+                throw std::runtime_error("parallel result differs");
+            println("-> {:2} threads  {:9.2f} ms, speedup {:.2f}", threads, timing.ms, seqMs / timing.ms);
+            if (threads == maxThreads) break;
+        }
+    }
+}
+
+#endif // AOC_BENCH_UTIL
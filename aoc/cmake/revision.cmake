@@ -0,0 +1,19 @@
+# (C) 2025 A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+# writes the git revision into OUTPUT (a header), run at build time by the target
+# aoc_revision; the file is only touched if the revision changed, so aoc.cpp is
+# only recompiled after a commit or checkout
+execute_process(COMMAND git rev-parse --short HEAD
+                WORKING_DIRECTORY ${SOURCE_DIR}
+                OUTPUT_VARIABLE revision OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+if(NOT revision)
+    set(revision "unknown")
+endif()
+
+set(content "// generated by cmake/revision.cmake\n#define AOC_GIT_REVISION \"${revision}\"\n")
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} old)
+endif()
+if(NOT "${old}" STREQUAL "${content}")
+    file(WRITE ${OUTPUT} "${content}")
+endif()
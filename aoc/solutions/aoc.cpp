@@ -2,9 +2,640 @@
 
 #include "aoc.hpp"
 
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define AOC_HAS_MMAP 1
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#if __has_include("aoc_revision.hpp")
+#include "aoc_revision.hpp"             // generated at build time, see cmake/revision.cmake
+#endif
+#ifndef AOC_GIT_REVISION
+#define AOC_GIT_REVISION "unknown"
+#endif
+
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define AOC_HAS_PERF 1
+#endif
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#define AOC_HAS_RUSAGE 1
+#endif
+
 /*
  * Most code is templated, but if not, this is the place.
  */
 
 namespace aoc {
+
+    namespace {
+
+        /*
+         * Two passes over the text: the first one only counts (out == nullptr), so the
+         * table is allocated once, the second one fills the spans in out. A '\n' at nl
+         * ends line 'count' and starts the next one at nl+1.
+         * Both return how far they got, the tail is left to the scalar version.
+         */
+
+        inline void newline_at(const size_t nl, LineSpan* out, size_t& count) {
+            if (out != nullptr) {
+                out[count].len = static_cast<uint32_t>(nl - out[count].offset);
+                out[count + 1].offset = static_cast<uint32_t>(nl + 1);
+            }
+            ++count;
+        }
+
+        // memchr is vectorized in most libcs, good enough as fallback and for the tail
+        void index_lines_scalar(const string_view text, size_t pos, LineSpan* out, size_t& count) {
+            const char* const first = text.data();
+            while (pos < text.size()) {
+                const auto p = static_cast<const char*>(std::memchr(first + pos, '\n', text.size() - pos));
+                if (p == nullptr) break;
+                const auto nl = static_cast<size_t>(p - first);
+                newline_at(nl, out, count);
+                pos = nl + 1;
+            }
+        }
+
+        // the bits of a match mask are the '\n' positions relative to pos
+        inline void emit(uint32_t mask, const size_t pos, LineSpan* out, size_t& count) {
+            if (out == nullptr) {
+                count += static_cast<size_t>(std::popcount(mask));
+                return;
+            }
+            while (mask != 0) {
+                newline_at(pos + static_cast<size_t>(std::countr_zero(mask)), out, count);
+                mask &= mask - 1;               // clear lowest bit
+            }
+        }
+
+#if defined(__SSE2__) || defined(_M_X64)
+        // compare 16 bytes at once
+        size_t index_lines_sse2(const string_view text, LineSpan* out, size_t& count) {
+            const char* const first = text.data();
+            const __m128i nl = _mm_set1_epi8('\n');
+
+            size_t pos = 0;
+            for (; pos + 16 <= text.size(); pos += 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + pos));
+                emit(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl))), pos, out, count);
+            }
+            return pos;
+        }
+#define AOC_HAS_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+        // same with 32 bytes, compiled for AVX2 but only called if the cpu has it
+        __attribute__((target("avx2")))
+        size_t index_lines_avx2(const string_view text, LineSpan* out, size_t& count) {
+            const char* const first = text.data();
+            const __m256i nl = _mm256_set1_epi8('\n');
+
+            size_t pos = 0;
+            for (; pos + 32 <= text.size(); pos += 32) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + pos));
+                emit(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, nl))), pos, out, count);
+            }
+            return pos;
+        }
+#define AOC_HAS_AVX2 1
+#endif
+
+        size_t index_lines_pass(const string_view text, LineSpan* out) {
+            size_t count = 0;
+            size_t pos = 0;
+#if defined(AOC_HAS_AVX2)
+            static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+            pos = hasAVX2 ? index_lines_avx2(text, out, count) : index_lines_sse2(text, out, count);
+#elif defined(AOC_HAS_SSE2)
+            pos = index_lines_sse2(text, out, count);
+#endif
+            index_lines_scalar(text, pos, out, count);
+            return count;
+        }
+
+    }
+
+    std::vector<LineSpan> index_lines(const string_view text) {
+        if (text.empty())
+            return {};                                  // no lines at all, like split
+        if (text.size() >= std::numeric_limits<uint32_t>::max())
+            throw std::runtime_error("text too large for a line index");
+
+        const size_t newlines = index_lines_pass(text, nullptr);
+
+        std::vector<LineSpan> lines(newlines + 1);
+        lines.front().offset = 0;
+        index_lines_pass(text, lines.data());
+        lines.back().len = static_cast<uint32_t>(text.size() - lines.back().offset);
+        return lines;
+    }
+
+    LineIndex::LineIndex(const string_view text, std::shared_ptr<const void> owner)
+        : text_(text), owner_(std::move(owner)), lines_(index_lines(text)) {
+        for (size_t i = 0; i < lines_.size(); ) {
+            while (i < lines_.size() && lines_[i].len == 0) ++i;
+            const size_t first = i;
+            while (i < lines_.size() && lines_[i].len != 0) ++i;
+            if (first < i)
+                blocks_.emplace_back(first, i);
+        }
+    }
+
+    std::vector<LineViews> LineViews::partition(const size_t k) const {
+        std::vector<LineViews> parts;
+        if (k == 0)
+            return parts;
+        parts.reserve(k);
+
+        // bytes are counted by offset, i.e. including the '\n's, a part starts at the first
+        // line beginning at or after its share
+        const auto& spans = index_->spans();
+        const auto first = spans.begin() + static_cast<std::ptrdiff_t>(first_);
+        const auto last = spans.begin() + static_cast<std::ptrdiff_t>(last_);
+        const size_t from = (first_ < last_) ? first->offset : 0;
+        const size_t bytes = (first_ < last_) ? spans[last_ - 1].offset + spans[last_ - 1].len + 1 - from : 0;
+
+        size_t begin = first_;
+        for (size_t i = 1; i <= k; ++i) {
+            size_t end = last_;
+            if (i < k) {
+                const size_t target = from + bytes * i / k;
+                end = static_cast<size_t>(std::lower_bound(first, last, target,
+                    [](const LineSpan& span, const size_t byte) { return span.offset < byte; }) - spans.begin());
+            }
+            parts.emplace_back(index_, begin, std::max(begin, end));
+            begin = std::max(begin, end);
+        }
+        return parts;
+    }
+
+#ifdef AOC_HAS_MMAP
+
+    MappedFile::MappedFile(const string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open file");
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat file");
+        }
+
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {                    // mmap of length 0 is an error, an empty view is fine
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map file");
+            }
+            ::madvise(p, size_, MADV_SEQUENTIAL);   // we parse front to back, read ahead
+            data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);                        // the mapping keeps its own reference
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_ != nullptr)
+            ::munmap(const_cast<char*>(data_), size_);
+    }
+
+#else
+
+    // no mmap, at least read it in one go without the stream copies
+    MappedFile::MappedFile(const string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw std::runtime_error("cannot open file");
+
+        size_ = static_cast<size_t>(in.tellg());
+        auto buffer = new char[size_ > 0 ? size_ : 1];
+        in.seekg(0);
+        in.read(buffer, static_cast<std::streamsize>(size_));
+        data_ = buffer;
+    }
+
+    MappedFile::~MappedFile() {
+        delete[] data_;
+    }
+
+#endif
+
+    const BenchConfig& bench_config() {
+        static const BenchConfig config = [] {
+            auto fromEnv = [](const char* name, const size_t otherwise) {
+                const char* value = std::getenv(name);
+                return (value != nullptr && *value != '\0') ? to_number<size_t>(value) : otherwise;
+            };
+            BenchConfig c;
+            c.runs = fromEnv("AOC_BENCH", 0);
+            c.warmup = (c.runs > 0) ? fromEnv("AOC_BENCH_WARMUP", std::max<size_t>(1, c.runs / 10)) : 0;
+            c.counters = fromEnv("AOC_PERF", 0) != 0;
+            return c;
+        }();
+        return config;
+    }
+
+    Timing timing_of(std::vector<double> samples) {
+        Timing t;
+        t.runs = samples.size();
+        if (samples.empty())
+            return t;
+
+        std::ranges::sort(samples);
+        const auto n = static_cast<double>(samples.size());
+        t.ms = samples.front();
+        t.median = (samples.size() % 2 == 1) ? samples[samples.size() / 2]
+                 : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+        t.p99 = samples[static_cast<size_t>(std::ceil(0.99 * n)) - 1];     // nearest rank
+        t.mean = std::ranges::fold_left(samples, 0.0, std::plus{}) / n;
+        const double sq = std::ranges::fold_left(samples, 0.0, [&](const double acc, const double x) { return acc + (x - t.mean) * (x - t.mean); });
+        t.stddev = (samples.size() > 1) ? std::sqrt(sq / (n - 1)) : 0.0;
+        return t;
+    }
+
+    void record(const solutions& answer, const Timing& timing) {
+        const char* path = std::getenv("AOC_RECORD");
+        if (path == nullptr || *path == '\0')
+            return;
+
+        const auto& info = run_info();
+        const bool csv = string_view(path).ends_with(".csv");
+        const bool isNew = !std::ifstream(path);
+        std::ofstream out(path, std::ios::app);
+        if (!out)
+            throw std::runtime_error("cannot write record");
+
+        if (csv) {
+            if (isNew)
+                out << "day,example,part1,part2,ms,runs,median,p99,stddev,input_bytes,revision\n";
+            out << format("{},{},{},{},{:.4f},{},{:.4f},{:.4f},{:.4f},{},{}\n",
+                          info.day, info.example, answer.part1, answer.part2, timing.ms, timing.runs,
+                          timing.median, timing.p99, timing.stddev, info.inputBytes, AOC_GIT_REVISION);
+        } else {
+            const auto& c = timing.counters;
+            const auto counters = !c.valid ? string{} :
+                format(R"(,"cycles":{},"instructions":{},"l1d_misses":{},"llc_misses":{},"branch_misses":{})",
+                       c.cycles, c.instructions, c.l1dMisses, c.llcMisses, c.branchMisses);
+            out << format(R"({{"day":{},"example":{},"part1":{},"part2":{},"ms":{:.4f},"runs":{},)"
+                          R"("median":{:.4f},"p99":{:.4f},"stddev":{:.4f},"input_bytes":{},"revision":"{}"{}}})" "\n",
+                          info.day, info.example, answer.part1, answer.part2, timing.ms, timing.runs,
+                          timing.median, timing.p99, timing.stddev, info.inputBytes, AOC_GIT_REVISION, counters);
+        }
+    }
+
+#ifdef AOC_HAS_PERF
+
+    namespace {
+        // in the order of the Counters members, the first one leads the group
+        constexpr std::array<std::pair<uint32_t, uint64_t>, 5> perfEvents = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+        // counts thread tid (0: the calling one) on any cpu
+        int open_perf_event(const uint32_t type, const uint64_t config, const int groupFd, const int tid) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = (groupFd == -1) ? 1 : 0;    // the group starts with its leader
+            attr.exclude_kernel = 1;                    // allowed with perf_event_paranoid 2
+            attr.exclude_hv = 1;
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attr, tid, -1, groupFd, 0));
+        }
+    }
+
+    // a group for this thread and one for each pool worker, the pool work is part of the run
+    PerfCounters::PerfCounters() {
+        ThreadPool::shared();
+        std::vector<int> tids{0};
+        std::ranges::copy(ThreadPool::worker_ids(), std::back_inserter(tids));
+        for (const int tid : tids) {
+            std::array<int, events> fds{-1, -1, -1, -1, -1};
+            fds[0] = open_perf_event(perfEvents[0].first, perfEvents[0].second, -1, tid);
+            if (fds[0] < 0)
+                continue;                               // no counters for this one
+            for (size_t i = 1; i < events; ++i)         // a missing one stays -1
+                fds[i] = open_perf_event(perfEvents[i].first, perfEvents[i].second, fds[0], tid);
+            groups_.push_back(fds);
+        }
+        total_.valid = !groups_.empty();
+        total_.threads = groups_.size();
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (const auto& fds : groups_)
+            for (const int fd : fds)
+                if (fd >= 0) ::close(fd);
+    }
+
+    void PerfCounters::start() {
+        for (const auto& fds : groups_) {
+            ::ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    void PerfCounters::stop() {
+        for (const auto& fds : groups_)
+            ::ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        std::array<uint64_t*, events> totals = {
+            &total_.cycles, &total_.instructions, &total_.l1dMisses, &total_.llcMisses, &total_.branchMisses
+        };
+        for (const auto& fds : groups_) {
+            for (size_t i = 0; i < events; ++i) {
+                uint64_t value = 0;
+                if (fds[i] >= 0 && ::read(fds[i], &value, sizeof(value)) == sizeof(value))
+                    *totals[i] += value;
+            }
+        }
+    }
+
+#else
+
+    PerfCounters::PerfCounters() = default;
+    PerfCounters::~PerfCounters() = default;
+    void PerfCounters::start() {}
+    void PerfCounters::stop() {}
+
+#endif
+
+#ifdef AOC_HAS_RUSAGE
+    size_t peak_rss_kib() {
+        rusage usage{};
+        if (::getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;    // bytes on macOS
+#else
+        return static_cast<size_t>(usage.ru_maxrss);           // KiB on Linux
+#endif
+    }
+#else
+    size_t peak_rss_kib() { return 0; }
+#endif
+
+    namespace {
+        thread_local bool inPoolTask = false;  // set while a thread runs pool tasks
+
+        // the OS ids of the running workers of all pools
+        std::mutex workerIdsMutex;
+        std::vector<int> workerIds;
+
+        int this_thread_id() {
+#ifdef AOC_HAS_PERF
+            return static_cast<int>(::syscall(SYS_gettid));
+#else
+            return -1;
+#endif
+        }
+    }
+
+    // returns when all workers are registered, so PerfCounters sees them
+    ThreadPool::ThreadPool(size_t threads) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        workers_.reserve(threads - 1);
+        const auto started = std::make_shared<std::latch>(static_cast<std::ptrdiff_t>(threads - 1));
+        for (size_t i = 1; i < threads; ++i) {
+            workers_.emplace_back([this, started] {
+                const int id = this_thread_id();
+                if (id >= 0) {
+                    std::lock_guard lock(workerIdsMutex);
+                    workerIds.push_back(id);
+                }
+                started->count_down();
+                work();
+                if (id >= 0) {
+                    std::lock_guard lock(workerIdsMutex);
+                    std::erase(workerIds, id);
+                }
+            });
+        }
+        started->wait();
+    }
+
+    std::vector<int> ThreadPool::worker_ids() {
+        std::lock_guard lock(workerIdsMutex);
+        return workerIds;
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    ThreadPool& ThreadPool::shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // takes task indices until none is left, shared by the workers and the caller
+    void ThreadPool::drain() {
+        inPoolTask = true;
+        for (size_t i = next_.fetch_add(1); i < tasks_; i = next_.fetch_add(1)) {
+            try {
+                (*task_)(i);
+            } catch (...) {
+                std::lock_guard lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+        inPoolTask = false;
+    }
+
+    void ThreadPool::work() {
+        size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+            drain();
+            {
+                std::lock_guard lock(mutex_);
+                ++finished_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void ThreadPool::run(const size_t tasks, const std::function<void(size_t)>& task) {
+        std::unique_lock runLock(runMutex_, std::try_to_lock);
+        if (inPoolTask || !runLock.owns_lock() || workers_.empty()) {
+            for (size_t i = 0; i < tasks; ++i)
+                task(i);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            task_ = &task;
+            tasks_ = tasks;
+            next_ = 0;
+            finished_ = 0;
+            error_ = nullptr;
+            ++generation_;
+        }
+        wake_.notify_all();
+        drain();
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [&] { return finished_ == workers_.size(); });
+        task_ = nullptr;
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+
+    void ClosestPairs::init() {
+        if (points_.size() > std::numeric_limits<uint32_t>::max())
+            throw std::runtime_error("ClosestPairs: too many points");
+        cursors_.assign(points_.size(), Cursor{});
+        if (points_.empty())
+            return;
+
+        Point3 max = points_.front();
+        min_ = max;
+        for (const auto& p : points_) {
+            min_ = {std::min(min_.x, p.x), std::min(min_.y, p.y), std::min(min_.z, p.z)};
+            max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+        }
+
+        // about two points per cell; a flat axis counts as one cell thick, so a few rounds
+        const std::array extent{max.x - min_.x + 1, max.y - min_.y + 1, max.z - min_.z + 1};
+        const double cells = std::max(1.0, static_cast<double>(points_.size()) / 2.0);
+        double cell = 1.0;
+        for (int round = 0; round < 4; ++round) {
+            double volume = 1.0;
+            for (const int64_t e : extent) volume *= std::max(static_cast<double>(e), cell);
+            cell = std::cbrt(volume / cells);
+        }
+        cell_ = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(cell)));
+        for (size_t a = 0; a < 3; ++a)
+            dims_[a] = (extent[a] - 1) / cell_ + 1;
+
+        // counting sort of the points by cell
+        auto linear = [&](const std::array<int64_t, 3>& c) { return static_cast<size_t>((c[2] * dims_[1] + c[1]) * dims_[0] + c[0]); };
+        cellStart_.assign(static_cast<size_t>(dims_[0] * dims_[1] * dims_[2]) + 1, 0);
+        for (const auto& p : points_)
+            ++cellStart_[linear(cell_of(p)) + 1];
+        std::partial_sum(cellStart_.begin(), cellStart_.end(), cellStart_.begin());
+        cellPoints_.resize(points_.size());
+        auto fill = cellStart_;
+        for (uint32_t i = 0; i < points_.size(); ++i)
+            cellPoints_[fill[linear(cell_of(points_[i]))]++] = i;
+
+        for (uint32_t i = 0; i < points_.size(); ++i)
+            push_head(i);
+    }
+
+    std::array<int64_t, 3> ClosestPairs::cell_of(const Point3& p) const noexcept {
+        return {(p.x - min_.x) / cell_, (p.y - min_.y) / cell_, (p.z - min_.z) / cell_};
+    }
+
+    // the cells at Chebyshev distance radius+1 from the cell of point i, then the new bound
+    void ClosestPairs::scan_ring(const uint32_t i) {
+        Cursor& cursor = cursors_[i];
+        const int64_t r = ++cursor.radius;
+        const Point3& p = points_[i];
+        const auto c = cell_of(p);
+
+        auto scan_cell = [&](const int64_t x, const int64_t y, const int64_t z) {
+            if (x < 0 || x >= dims_[0] || y < 0 || y >= dims_[1] || z < 0 || z >= dims_[2])
+                return;
+            const auto cell = static_cast<size_t>((z * dims_[1] + y) * dims_[0] + x);
+            for (uint32_t k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+                if (const uint32_t j = cellPoints_[k]; j > i) {
+                    cursor.heap.emplace_back(dist2(p, points_[j]), j);
+                    std::ranges::push_heap(cursor.heap, std::greater{});
+                }
+            }
+        };
+
+        // the surface of the cube of cells, x and y over the full range, z only at the caps inside
+        for (int64_t dx = -r; dx <= r; ++dx) {
+            for (int64_t dy = -r; dy <= r; ++dy) {
+                if (std::abs(dx) == r || std::abs(dy) == r) {
+                    for (int64_t dz = -r; dz <= r; ++dz)
+                        scan_cell(c[0] + dx, c[1] + dy, c[2] + dz);
+                } else {
+                    scan_cell(c[0] + dx, c[1] + dy, c[2] - r);
+                    if (r > 0) scan_cell(c[0] + dx, c[1] + dy, c[2] + r);
+                }
+            }
+        }
+
+        // points not scanned yet lie outside the cube, at least this far away
+        const std::array pos{p.x - min_.x, p.y - min_.y, p.z - min_.z};
+        int64_t bound = std::numeric_limits<int64_t>::max();
+        for (size_t a = 0; a < 3; ++a) {
+            if (c[a] - r > 0) bound = std::min(bound, pos[a] - (c[a] - r) * cell_);
+            if (c[a] + r < dims_[a] - 1) bound = std::min(bound, (c[a] + r + 1) * cell_ - pos[a]);
+        }
+        cursor.complete = bound == std::numeric_limits<int64_t>::max();
+        cursor.bound2 = cursor.complete ? bound : bound * bound;
+    }
+
+    // scans rings until the smallest candidate of i is certain; false if there is none
+    bool ClosestPairs::make_certain(const uint32_t i) {
+        Cursor& cursor = cursors_[i];
+        while (!cursor.complete && (cursor.heap.empty() || cursor.heap.front().first >= cursor.bound2))
+            scan_ring(i);
+        return !cursor.heap.empty();
+    }
+
+    void ClosestPairs::push_head(const uint32_t i) {
+        if (!make_certain(i))
+            return;
+        const auto [dist, j] = cursors_[i].heap.front();
+        heap_.push_back(PointPair{i, j, dist});
+        std::ranges::push_heap(heap_, std::greater{});
+    }
+
+    std::optional<PointPair> ClosestPairs::next() {
+        if (heap_.empty())
+            return std::nullopt;
+        std::ranges::pop_heap(heap_, std::greater{});
+        const PointPair top = heap_.back();
+        heap_.pop_back();
+
+        auto& candidates = cursors_[top.i].heap;
+        std::ranges::pop_heap(candidates, std::greater{});
+        candidates.pop_back();
+        push_head(top.i);
+        return top;
+    }
 }
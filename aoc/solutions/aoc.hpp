@@ -4,9 +4,17 @@
 #define AOC_COMPLETE
 
 #include "aoc_uses.hpp"
+#include "aoc_run.hpp"
 #include "aoc_solution.hpp"
 #include "aoc_conversions.hpp"
+#include "aoc_scan.hpp"
 #include "aoc_input.hpp"
 #include "aoc_field.hpp"
+#include "aoc_bitfield.hpp"
+#include "aoc_flat.hpp"
+#include "aoc_sparse.hpp"
+#include "aoc_memo.hpp"
+#include "aoc_points.hpp"
+#include "aoc_parallel.hpp"
 
 #endif // AOC_COMPLETE
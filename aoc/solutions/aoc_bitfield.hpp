@@ -0,0 +1,169 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_BITFIELD
+#define AOC_BITFIELD
+
+#include "aoc_uses.hpp"
+#include "aoc_field.hpp"
+
+namespace aoc {
+
+    /*
+     * A field of bits, e.g. occupied or not, one bit per cell instead of a char.
+     * Each row is packed into 64-bit words, cell (row,col) is bit col+1 of the row, so
+     * bit 0 is a padding column (as is everything after col cols). With a zero row
+     * above and below, shifted neighbor words never need a bounds check.
+     * Neighbor counts are done word-parallel, 64 cells at once: the neighbor words
+     * (shifted by one bit for the columns) are summed up in bit-sliced counters.
+     */
+    class BitField {
+        index_t rows_{0};
+        index_t cols_{0};
+        index_t words_{0};                  // per row
+        std::vector<uint64_t> data_;        // rows_+2 rows, the first and last one stay 0
+
+        [[nodiscard]] const uint64_t* row(const index_t r) const noexcept { return data_.data() + (r + 1) * words_; }
+        uint64_t* row(const index_t r) noexcept { return data_.data() + (r + 1) * words_; }
+
+        static constexpr size_t bit_of(const index_t col) noexcept { return static_cast<size_t>(col + 1); }
+
+        // the valid bits of word w, i.e. without the padding
+        [[nodiscard]] uint64_t mask(const index_t w) const noexcept {
+            const index_t first = w * 64;
+            const index_t lo = std::max<index_t>(1, first);
+            const index_t hi = std::min<index_t>(cols_ + 1, first + 64);
+            if (lo >= hi) return 0;
+            const auto n = static_cast<unsigned>(hi - lo);
+            const uint64_t bits = (n == 64) ? ~uint64_t{0} : ((uint64_t{1} << n) - 1);
+            return bits << static_cast<unsigned>(lo - first);
+        }
+
+        // word w of row r seen from column offset dc, i.e. bit i is the cell at col i+dc
+        [[nodiscard]] uint64_t shifted(const uint64_t* r, const index_t w, const index_t dc) const noexcept {
+            if (dc == 0) return r[w];
+            if (dc < 0) return (r[w] << 1) | (w > 0 ? r[w - 1] >> 63 : 0);
+            return (r[w] >> 1) | (w + 1 < words_ ? r[w + 1] << 63 : 0);
+        }
+
+        /*
+         * For each word, counts the set neighbors of all 64 cells in four bit planes
+         * (counts up to 15) and hands them to f(row, word, planes).
+         */
+        template <typename Neighborhood, typename F>
+        void for_each_count(F&& f) const {
+            constexpr auto& offsets = Neighborhood::offsets;
+            static_assert(std::ranges::all_of(offsets, [](const RC o) { return o.row >= -1 && o.row <= 1 && o.col >= -1 && o.col <= 1; }),
+                          "BitField: only neighborhoods within distance 1");
+
+            for (index_t r = 0; r < rows_; ++r) {
+                const std::array<const uint64_t*, 3> rows{ row(r - 1), row(r), row(r + 1) };
+                for (index_t w = 0; w < words_; ++w) {
+                    std::array<uint64_t, 4> planes{};
+                    for (const RC o : offsets) {
+                        uint64_t carry = shifted(rows[static_cast<size_t>(o.row + 1)], w, o.col);
+                        for (auto& plane : planes) {            // ripple-carry add of one bit
+                            const uint64_t next = plane & carry;
+                            plane ^= carry;
+                            carry = next;
+                        }
+                    }
+                    f(r, w, planes);
+                }
+            }
+        }
+
+    public:
+        BitField() = default;
+        BitField(const index_t rows, const index_t cols)
+            : rows_(rows), cols_(cols), words_((cols + 2 + 63) / 64), data_(static_cast<size_t>((rows + 2) * words_), 0) {}
+
+        [[nodiscard]] index_t rows() const noexcept { return rows_; }
+        [[nodiscard]] index_t cols() const noexcept { return cols_; }
+        [[nodiscard]] size_t bytes() const noexcept { return data_.size() * sizeof(uint64_t); }
+
+        [[nodiscard]] bool isValid(const RC rc) const { return rc.row >= 0 && rc.row < rows() && rc.col >= 0 && rc.col < cols(); }
+
+        [[nodiscard]] bool operator[](const index_t r, const index_t c) const noexcept {
+            return (row(r)[bit_of(c) / 64] >> (bit_of(c) % 64)) & 1;
+        }
+        [[nodiscard]] bool operator[](const RC& rc) const noexcept { return (*this)[rc.row, rc.col]; }
+
+        void set(const index_t r, const index_t c, const bool value = true) noexcept {
+            const uint64_t bit = uint64_t{1} << (bit_of(c) % 64);
+            uint64_t& word = row(r)[bit_of(c) / 64];
+            word = value ? (word | bit) : (word & ~bit);
+        }
+        void set(const RC& rc, const bool value = true) noexcept { set(rc.row, rc.col, value); }
+
+        [[nodiscard]] size_t count() const noexcept {
+            size_t n = 0;
+            for (const uint64_t word : data_) n += static_cast<size_t>(std::popcount(word));
+            return n;
+        }
+
+        BitField& operator&=(const BitField& other) noexcept {
+            for (size_t i = 0; i < data_.size(); ++i) data_[i] &= other.data_[i];
+            return *this;
+        }
+        BitField& operator|=(const BitField& other) noexcept {
+            for (size_t i = 0; i < data_.size(); ++i) data_[i] |= other.data_[i];
+            return *this;
+        }
+        // clears all bits set in other, i.e. this & ~other
+        BitField& remove(const BitField& other) noexcept {
+            for (size_t i = 0; i < data_.size(); ++i) data_[i] &= ~other.data_[i];
+            return *this;
+        }
+        friend BitField operator&(BitField lhs, const BitField& rhs) noexcept { return lhs &= rhs; }
+        friend BitField operator|(BitField lhs, const BitField& rhs) noexcept { return lhs |= rhs; }
+
+        // all cells (set or not) with fewer than k set neighbors
+        template <typename Neighborhood>
+        [[nodiscard]] BitField neighbors_below(const unsigned k) const {
+            BitField result(rows_, cols_);
+            for_each_count<Neighborhood>([&](const index_t r, const index_t w, const std::array<uint64_t, 4>& planes) {
+                uint64_t lt = 0, eq = ~uint64_t{0};     // count < k, compared from the high bit down
+                for (size_t b = planes.size(); b-- > 0; ) {
+                    const uint64_t kb = ((k >> b) & 1) ? ~uint64_t{0} : 0;
+                    lt |= eq & ~planes[b] & kb;
+                    eq &= ~(planes[b] ^ kb);
+                }
+                if (k > 15) lt = ~uint64_t{0};
+                result.row(r)[w] = lt & mask(w);
+            });
+            return result;
+        }
+
+        // the number of set neighbors of each cell
+        template <typename Neighborhood>
+        [[nodiscard]] Field<uint8_t> neighbor_counts() const {
+            Field<uint8_t> result(rows_, cols_);
+            for_each_count<Neighborhood>([&](const index_t r, const index_t w, const std::array<uint64_t, 4>& planes) {
+                const index_t first = std::max<index_t>(0, w * 64 - 1);
+                const index_t last = std::min<index_t>(cols_, w * 64 + 63);
+                for (index_t c = first; c < last; ++c) {
+                    const auto bit = bit_of(c) % 64;
+                    result[r, c] = static_cast<uint8_t>(((planes[0] >> bit) & 1) | (((planes[1] >> bit) & 1) << 1)
+                                                      | (((planes[2] >> bit) & 1) << 2) | (((planes[3] >> bit) & 1) << 3));
+                }
+            });
+            return result;
+        }
+
+        // one bit per cell of field, set where pred(value) holds
+        template <typename T, typename Pred>
+        static BitField of(const Field<T>& field, Pred&& pred) {
+            BitField bits(field.rows(), field.cols());
+            for_each_cell(field, [&](const RC rc, const T& value) { if (pred(value)) bits.set(rc); });
+            return bits;
+        }
+    };
+
+    // e.g. to_bit_field(field, [](char c) { return c == '@'; })
+    template <typename T, typename Pred>
+    BitField to_bit_field(const Field<T>& field, Pred&& pred) {
+        return BitField::of(field, std::forward<Pred>(pred));
+    }
+}
+
+#endif // AOC_BITFIELD
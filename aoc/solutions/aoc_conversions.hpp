@@ -27,16 +27,55 @@ namespace aoc {
         return format("{}", x);
     }
 
+    inline constexpr string_view whitespace = " \t\n\v\f\r";
+
+    /*
+     * Calls f for every number in line. Numbers are separated by any run of chars
+     * from delims, e.g. ", " for '1, 2,3'. No copies, no streams, no allocation,
+     * but an invalid number throws like to_number does. Returns the count.
+     */
+    template<typename T, typename F>
+    size_t for_each_number(const string_view line, const string_view delims, F&& f) {
+        const char* p = line.data();
+        const char* const last = line.data() + line.size();
+        auto isDelim = [&](const char c) { return delims.find(c) != string_view::npos; };
+
+        size_t count = 0;
+        while (true) {
+            while (p != last && isDelim(*p)) ++p;
+            if (p == last)
+                return count;
+
+            if (*p == '+' && p + 1 != last && !isDelim(p[1])) ++p;   // from_chars does not like '+'
+            T value{};
+            const auto [next, ec] = std::from_chars(p, last, value);
+            if (ec != std::errc() || (next != last && !isDelim(*next)))
+                throw std::runtime_error(format("Invalid number in: {}", line));
+            f(value);
+            ++count;
+            p = next;
+        }
+    }
+
+    /*
+     * Bulk version: writes the numbers of line to out and returns how many numbers
+     * the line has. Numbers beyond out.size() are checked and counted, but not stored,
+     * so 'scan_numbers(line, out) == out.size()' checks for an exact fit.
+     */
     template<typename T>
-    std::vector<T> to_numbers(const string_view line) {
-        std::istringstream iss{string(line)};
+    size_t scan_numbers(const string_view line, std::span<T> out, const string_view delims = whitespace) {
+        size_t idx = 0;
+        return for_each_number<T>(line, delims, [&](const T x) {
+            if (idx < out.size()) out[idx] = x;
+            ++idx;
+        });
+    }
+
+    template<typename T>
+    std::vector<T> to_numbers(const string_view line, const string_view delims = whitespace) {
         std::vector<T> values;
-        T x;
-        while (iss >> x) {   // operator>> automatically skips whitespace
-            values.push_back(x);
-        }
+        for_each_number<T>(line, delims, [&](const T x) { values.push_back(x); });
         return values;
     }
-
 }
 #endif // AOC_CONVERSIONS
@@ -6,6 +6,7 @@
 #include "aoc_uses.hpp"
 #include "aoc_conversions.hpp"
 #include "aoc_input.hpp"
+#include "aoc_parallel.hpp"
 
 namespace aoc {
 
@@ -24,18 +25,193 @@ namespace aoc {
         friend RC operator+(RC lhs, const RC rhs) noexcept { return lhs+=rhs; }
     };
 
+    /*
+     * A non-owning 2D view with strides, e.g. on a Field: rows, columns, sub-rectangles
+     * and the transposed view are all just other strides, nothing is copied.
+     * Rows and columns come as random-access ranges of references. If the standard
+     * library has std::mdspan, mdspan() gives the same view as one.
+     */
     template <typename T>
-    class Field {
+    class FieldView {
+        T* data_{nullptr};
+        index_t rows_{0};
+        index_t cols_{0};
+        index_t rowStride_{0};
+        index_t colStride_{1};
+
+        // n elements from first, stride apart
+        static auto strided(T* first, const index_t n, const index_t stride) {
+            return std::views::iota(index_t{0}, n)
+                | std::views::transform([first, stride](const index_t i) -> T& { return first[i * stride]; });
+        }
+
     public:
-        using value_type = T;
+        using value_type = std::remove_const_t<T>;
 
-        Field() : rows_(0), cols_(0) {}
-        Field(const index_t rows, const index_t cols) : rows_(rows), cols_(cols), data_(rows * cols) {}
+        FieldView() = default;
+        FieldView(T* data, const index_t rows, const index_t cols, const index_t rowStride, const index_t colStride = 1)
+            : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride), colStride_(colStride) {}
 
         [[nodiscard]] index_t rows() const noexcept { return rows_; }
         [[nodiscard]] index_t cols() const noexcept { return cols_; }
+        [[nodiscard]] index_t rowStride() const noexcept { return rowStride_; }
+        [[nodiscard]] index_t colStride() const noexcept { return colStride_; }
+        [[nodiscard]] T* data() const noexcept { return data_; }
+
+        T& operator[](const index_t row, const index_t col) const noexcept { return data_[row * rowStride_ + col * colStride_]; }
+        T& operator[](const RC& rc) const noexcept { return (*this)[rc.row, rc.col]; }
 
-        void resize(const index_t rows, const index_t cols) { rows_=rows; cols_=cols; data_.resize(rows_ * cols_); }
+        [[nodiscard]] auto row(const index_t r) const { return strided(data_ + r * rowStride_, cols_, colStride_); }
+        [[nodiscard]] auto col(const index_t c) const { return strided(data_ + c * colStride_, rows_, rowStride_); }
+
+        [[nodiscard]] FieldView sub(const RC first, const index_t rows, const index_t cols) const noexcept {
+            return {&(*this)[first], rows, cols, rowStride_, colStride_};
+        }
+        [[nodiscard]] FieldView transposed() const noexcept { return {data_, cols_, rows_, colStride_, rowStride_}; }
+
+#ifdef __cpp_lib_mdspan
+        [[nodiscard]] auto mdspan() const {
+            using extents = std::dextents<index_t, 2>;
+            const std::layout_stride::mapping<extents> mapping(extents(rows_, cols_), std::array{rowStride_, colStride_});
+            return std::mdspan<T, extents, std::layout_stride>(data_, mapping);
+        }
+#endif
+    };
+
+    // edge length of the tiles of a transpose, a tile of both fields fits into L1
+    inline constexpr index_t transpose_tile = 32;
+
+    // dst[c,r] = src[r,c], in tiles, so that neither side strides through the whole field
+    template <typename T>
+    void transpose(const FieldView<const T> src, const FieldView<T> dst) {
+        if (dst.rows() != src.cols() || dst.cols() != src.rows())
+            throw std::runtime_error("transpose: dimensions do not match");
+        for (index_t r0 = 0; r0 < src.rows(); r0 += transpose_tile)
+            for (index_t c0 = 0; c0 < src.cols(); c0 += transpose_tile)
+                for (index_t r = r0; r < std::min(r0 + transpose_tile, src.rows()); ++r)
+                    for (index_t c = c0; c < std::min(c0 + transpose_tile, src.cols()); ++c)
+                        dst[c, r] = src[r, c];
+    }
+
+    /*
+     * Storage layouts of a Field, given as a template parameter, so the index
+     * translation is inlined and there is no dispatch at runtime. A layout is
+     * constructed with the full extents (including the border) and maps (row, col)
+     * to a position in a buffer of size() cells.
+     *  - RowMajor: rows one after another, the default; only here rows are
+     *    contiguous, so stride(), data() and views exist only for this one,
+     *  - Tiled<Tile>: square Tile x Tile tiles in row-major order, row-major within,
+     *    so vertical neighbors are at most Tile cells apart (instead of a full row),
+     *  - Morton: Z-order within square blocks of up to 1024 x 1024 cells (blocks in
+     *    row-major order, so a long, narrow field does not waste a square of memory).
+     */
+    struct RowMajor {
+        index_t cols{0};
+        index_t cells{0};
+
+        RowMajor() = default;
+        RowMajor(const index_t rows, const index_t cols) : cols(cols), cells(rows * cols) {}
+
+        [[nodiscard]] index_t size() const noexcept { return cells; }
+        [[nodiscard]] index_t operator()(const index_t row, const index_t col) const noexcept { return row * cols + col; }
+    };
+
+    template <index_t Tile = 16>
+    struct Tiled {
+        static_assert(Tile > 0 && std::has_single_bit(static_cast<uint64_t>(Tile)), "Tiled: Tile must be a power of 2");
+        static constexpr index_t tile = Tile;
+
+        index_t tilesPerRow{0};
+        index_t cells{0};
+
+        Tiled() = default;
+        Tiled(const index_t rows, const index_t cols)
+            : tilesPerRow((cols + Tile - 1) / Tile), cells((rows + Tile - 1) / Tile * tilesPerRow * Tile * Tile) {}
+
+        [[nodiscard]] index_t size() const noexcept { return cells; }
+        // row, col >= 0 here, unsigned makes / and % plain shifts and masks
+        [[nodiscard]] index_t operator()(const index_t row, const index_t col) const noexcept {
+            constexpr auto t = static_cast<uint64_t>(Tile);
+            const auto r = static_cast<uint64_t>(row), c = static_cast<uint64_t>(col);
+            return static_cast<index_t>(((r / t) * static_cast<uint64_t>(tilesPerRow) + c / t) * (t * t) + (r % t) * t + c % t);
+        }
+    };
+
+    struct Morton {
+        static constexpr unsigned maxShift = 10;   // blocks of at most 1024 x 1024
+
+        unsigned shift{0};                          // the block side is 1 << shift
+        index_t blocksPerRow{0};
+        index_t cells{0};
+
+        Morton() = default;
+        Morton(const index_t rows, const index_t cols)
+            : shift(std::min(maxShift, static_cast<unsigned>(std::bit_width(static_cast<uint64_t>(std::max<index_t>(1, std::min(rows, cols)) - 1))))),
+              blocksPerRow(((cols - 1) >> shift) + 1),
+              cells((((rows - 1) >> shift) + 1) * blocksPerRow << (2 * shift)) {}
+
+        // the bits of x (< 2^16) spread to the even bits
+        static constexpr uint32_t spread(uint32_t x) noexcept {
+            x = (x | (x << 8)) & 0x00ff00ffu;
+            x = (x | (x << 4)) & 0x0f0f0f0fu;
+            x = (x | (x << 2)) & 0x33333333u;
+            x = (x | (x << 1)) & 0x55555555u;
+            return x;
+        }
+
+        [[nodiscard]] index_t size() const noexcept { return cells; }
+        [[nodiscard]] index_t operator()(const index_t row, const index_t col) const noexcept {
+            const index_t mask = (index_t{1} << shift) - 1;
+            const index_t block = (row >> shift) * blocksPerRow + (col >> shift);
+            const auto z = (spread(static_cast<uint32_t>(row & mask)) << 1) | spread(static_cast<uint32_t>(col & mask));
+            return (block << (2 * shift)) + static_cast<index_t>(z);
+        }
+    };
+
+    /*
+     * rows x cols cells, row-major by default (see above for the other layouts).
+     * Optionally with a border ring of 'border' sentinel
+     * cells around it, i.e. row and col may go from -border to rows-1+border and the
+     * rows are stride() = cols+2*border apart. Then neighbors of an inner cell are at
+     * fixed linear offsets (±1, ±stride, see linear_offsets) and need no bounds check.
+     * data() points to cell (0,0) in both cases; rows(), cols(), isValid() and
+     * positions() refer to the inner cells only.
+     */
+    template <typename T, typename Layout = RowMajor>
+    class Field {
+    public:
+        using value_type = T;
+        using layout_type = Layout;
+        static constexpr bool is_row_major = std::same_as<Layout, RowMajor>;
+
+        Field() : rows_(0), cols_(0), border_(0) {}
+        Field(const index_t rows, const index_t cols, const index_t border = 0, const T& fill = T{})
+            : rows_(rows), cols_(cols), border_(border), layout_(rows + 2 * border, cols + 2 * border),
+              data_(static_cast<size_t>(layout_.size()), fill) {}
+
+        // the same cells (and border) in another layout
+        template <typename OtherLayout> requires (!std::same_as<OtherLayout, Layout>)
+        explicit Field(const Field<T, OtherLayout>& other)
+            : Field(other.rows(), other.cols(), other.border()) {
+            for (index_t row = -border_; row < rows_ + border_; ++row)
+                for (index_t col = -border_; col < cols_ + border_; ++col)
+                    (*this)[row, col] = other[row, col];
+        }
+
+        [[nodiscard]] index_t rows() const noexcept { return rows_; }
+        [[nodiscard]] index_t cols() const noexcept { return cols_; }
+        [[nodiscard]] index_t border() const noexcept { return border_; }
+        [[nodiscard]] const Layout& layout() const noexcept { return layout_; }
+        [[nodiscard]] index_t stride() const noexcept requires is_row_major { return cols_ + 2 * border_; }
+
+        // cells in both sizes keep their value at (row,col), all others, the border included, get fill
+        void resize(const index_t rows, const index_t cols, const T& fill = T{}) requires is_row_major {
+            Field resized(rows, cols, border_, fill);
+            for (index_t row = 0; row < std::min(rows, rows_); ++row)
+                std::ranges::move(data_.begin() + linear_index(row, 0), data_.begin() + linear_index(row, std::min(cols, cols_)),
+                                  resized.data_.begin() + resized.linear_index(row, 0));
+            *this = std::move(resized);
+        }
 
         [[nodiscard]] bool isValid(const RC rc) const { return rc.row >= 0 && rc.row < rows() && rc.col >= 0 && rc.col < cols(); }
 
@@ -45,29 +221,64 @@ namespace aoc {
         value_type& operator[](const RC& rc) noexcept { return (*this)[rc.row,rc.col]; }
         const value_type& operator[](const RC& rc) const noexcept { return (*this)[rc.row,rc.col]; }
 
-        value_type* data() noexcept { return data_.data(); }
-        [[nodiscard]] const value_type* data() const noexcept { return data_.data(); }
+        value_type* data() noexcept requires is_row_major { return data_.data() + origin(); }
+        [[nodiscard]] const value_type* data() const noexcept requires is_row_major { return data_.data() + origin(); }
+
+        // the offsets of a neighborhood relative to a cell pointer, needs border() >= 1
+        template <typename Neighborhood>
+        [[nodiscard]] auto linear_offsets() const noexcept requires is_row_major {
+            std::array<std::ptrdiff_t, Neighborhood::offsets.size()> result{};
+            for (size_t i = 0; i < result.size(); ++i)
+                result[i] = Neighborhood::offsets[i].row * stride() + Neighborhood::offsets[i].col;
+            return result;
+        }
+
+        // views on the inner cells, no copies
+        [[nodiscard]] FieldView<T> view() noexcept requires is_row_major { return {data(), rows_, cols_, stride()}; }
+        [[nodiscard]] FieldView<const T> view() const noexcept requires is_row_major { return {data(), rows_, cols_, stride()}; }
+
+        // a contiguous transposed copy, tiled; the border ring is transposed along, so it keeps its sentinels
+        [[nodiscard]] Field transposed() const requires is_row_major {
+            Field tmp(cols_, rows_, border_);
+            aoc::transpose(padded_view(), tmp.padded_view());
+            return tmp;
+        }
 
-        // void transpose() {
-        //     Field<T> tmp(cols_, rows_);
-        //     for (index_t row = 0; row < rows_; ++row)
-        //         for (index_t col = 0; col < cols_; ++col)
-        //             tmp[col,row] = (*this)[row,col];
-        //     //*this = tmp;
-        //     std::swap(rows_, cols_);
-        //     std::swap(data_,tmp.data_);
-        // }
+        // in place for a square field without border, otherwise through a copy
+        void transpose() requires is_row_major {
+            if (rows_ == cols_ && border_ == 0) {
+                for (index_t r0 = 0; r0 < rows_; r0 += transpose_tile)
+                    for (index_t c0 = r0; c0 < cols_; c0 += transpose_tile)
+                        for (index_t r = r0; r < std::min(r0 + transpose_tile, rows_); ++r)
+                            for (index_t c = std::max(c0, r + 1); c < std::min(c0 + transpose_tile, cols_); ++c)
+                                std::swap((*this)[r,c], (*this)[c,r]);
+                return;
+            }
+            *this = transposed();
+        }
 
     private:
-        [[nodiscard]] index_t linear_index(const index_t row, const index_t col) const noexcept { return col + row * cols_; }
+        // all cells, the border included
+        [[nodiscard]] FieldView<T> padded_view() noexcept requires is_row_major { return {data_.data(), rows_ + 2 * border_, cols_ + 2 * border_, stride()}; }
+        [[nodiscard]] FieldView<const T> padded_view() const noexcept requires is_row_major { return {data_.data(), rows_ + 2 * border_, cols_ + 2 * border_, stride()}; }
+
+        [[nodiscard]] index_t origin() const noexcept requires is_row_major { return border_ * stride() + border_; }
+        [[nodiscard]] index_t linear_index(const index_t row, const index_t col) const noexcept {
+            if constexpr (is_row_major)
+                return origin() + col + row * stride();
+            else
+                return layout_(row + border_, col + border_);
+        }
 
         index_t rows_;
         index_t cols_;
+        index_t border_;
+        Layout layout_{};
         std::vector<T> data_;
     };
 
-    template <typename T>
-    void print(const Field<T> &field, const string &delim = "") {
+    template <typename T, typename L>
+    void print(const Field<T, L> &field, const string &delim = "") {
         for (index_t row = 0; row < field.rows(); ++row) {
             for (index_t col = 0; col < field.cols(); ++col)
                 std::cout << field[row,col] << delim;
@@ -75,16 +286,18 @@ namespace aoc {
         }
     }
 
+    // all inner positions row by row; a row/col cursor, no division per step
     template <typename T>
     class Positions {
         index_t rows_;
         index_t cols_;
 
     public:
-        explicit Positions(const Field<T>& f) : rows_(f.rows()), cols_(f.cols()) {}
+        template <typename L>
+        explicit Positions(const Field<T, L>& f) : rows_(f.rows()), cols_(f.cols()) {}
 
         class iterator {
-            index_t idx_ = 0;
+            RC rc_{};
             index_t cols_ = 0;
 
         public:
@@ -96,12 +309,12 @@ namespace aoc {
 
             iterator() = default;
 
-            iterator(const index_t idx, const index_t cols) : idx_(idx), cols_(cols) {}
+            iterator(const RC rc, const index_t cols) : rc_(rc), cols_(cols) {}
 
-            RC operator*() const noexcept { return RC{ idx_ / cols_, idx_ % cols_ }; }
+            RC operator*() const noexcept { return rc_; }
 
             iterator& operator++() {
-                ++idx_;
+                if (++rc_.col == cols_) { rc_.col = 0; ++rc_.row; }
                 return *this;
             }
 
@@ -111,32 +324,100 @@ namespace aoc {
                 return tmp;
             }
 
-            bool operator==(const iterator& other) const noexcept { return idx_ == other.idx_; }
+            bool operator==(const iterator& other) const noexcept { return rc_ == other.rc_; }
             bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
         };
 
-        [[nodiscard]] iterator begin() const noexcept { return iterator(0, cols_); }
-        [[nodiscard]] iterator end()   const noexcept { return iterator(rows_ * cols_, cols_); }
+        [[nodiscard]] iterator begin() const noexcept { return iterator(RC{0, 0}, cols_); }
+        [[nodiscard]] iterator end()   const noexcept { return iterator(RC{cols_ > 0 ? rows_ : 0, 0}, cols_); }
     };
 
-    template <typename T>
-    Positions<T> positions(const Field<T>& f) {
+    template <typename T, typename L>
+    Positions<T> positions(const Field<T, L>& f) {
         return Positions<T>(f);
     }
 
-    template <typename T, typename Neighborhood>
+    namespace field_detail {
+        template <typename T, typename F>
+        void for_each_cell_in_rows(T& field, const index_t first, const index_t last, F& f) {
+            for (index_t row = first; row < last; ++row) {
+                if constexpr (std::remove_const_t<T>::is_row_major) {
+                    auto* const cells = field.data() + row * field.stride();
+                    for (index_t col = 0; col < field.cols(); ++col) {
+                        if constexpr (std::invocable<F&, decltype(cells[col])>)
+                            f(cells[col]);
+                        else
+                            f(RC{row, col}, cells[col]);
+                    }
+                } else {
+                    for (index_t col = 0; col < field.cols(); ++col) {
+                        if constexpr (std::invocable<F&, decltype(field[row, col])>)
+                            f(field[row, col]);
+                        else
+                            f(RC{row, col}, field[row, col]);
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     * Calls f(value) or f(rc, value) for all inner cells, row by row as two plain
+     * loops over the row pointers, so the compiler can vectorize the inner one
+     * (other layouts than RowMajor go through operator[]).
+     * value is a reference, so f may change it for a non-const field.
+     */
+    template <typename T, typename L, typename F>
+    void for_each_cell(Field<T, L>& field, F&& f) {
+        field_detail::for_each_cell_in_rows(field, 0, field.rows(), f);
+    }
+
+    template <typename T, typename L, typename F>
+    void for_each_cell(const Field<T, L>& field, F&& f) {
+        field_detail::for_each_cell_in_rows(field, 0, field.rows(), f);
+    }
+
+    namespace field_detail {
+        template <typename Fld, typename F>
+        void par_for_each_cell_in_bands(Fld& field, F& f, ThreadPool& pool) {
+            const auto cells = static_cast<size_t>(field.rows() * field.cols());
+            const auto bands = static_cast<index_t>(std::min(pool.size(), cells / par_min_part_size));
+            if (bands <= 1) {
+                for_each_cell_in_rows(field, 0, field.rows(), f);
+                return;
+            }
+            pool.run(static_cast<size_t>(bands), [&](const size_t band) {
+                const auto b = static_cast<index_t>(band);
+                for_each_cell_in_rows(field, field.rows() * b / bands, field.rows() * (b + 1) / bands, f);
+            });
+        }
+    }
+
+    // the same in bands of rows on the thread pool, so f is called concurrently
+    template <typename T, typename L, typename F>
+    void par_for_each_cell(Field<T, L>& field, F&& f, ThreadPool& pool = ThreadPool::shared()) {
+        field_detail::par_for_each_cell_in_bands(field, f, pool);
+    }
+
+    template <typename T, typename L, typename F>
+    void par_for_each_cell(const Field<T, L>& field, F&& f, ThreadPool& pool = ThreadPool::shared()) {
+        field_detail::par_for_each_cell_in_bands(field, f, pool);
+    }
+
+    // the valid neighbors of center; Grid is a Field (of any layout) or anything with isValid(rc)
+    template <typename T, typename Neighborhood, typename Grid = Field<T>>
     class Halo {
-        const Field<T>& field_;
+        const Grid& field_;
         const RC center_;
 
     public:
-        Halo(const Field<T>& field, const RC center) : field_(field), center_(center) {}
+        Halo(const Grid& field, const RC center) : field_(field), center_(center) {}
 
         // To use the iterator with ranges-algorithms, it must fulfill the range-requirements.
         class iterator {
             static constexpr auto &offsets = Neighborhood::offsets;
 
-            const Field<T>* field_{};
+            const Grid* field_{};
             RC center_{};
             size_t idx_{};
 
@@ -155,7 +436,7 @@ namespace aoc {
 
             iterator() = default;
 
-            iterator(const Field<T>& field, const RC center, const size_t idx)
+            iterator(const Grid& field, const RC center, const size_t idx)
                 : field_(&field), center_(center), idx_(idx) { untilValid(); }
 
             RC operator*() const { return center_ + offsets[idx_]; }
@@ -205,19 +486,205 @@ namespace aoc {
         };
     };
 
-    template <typename T>
-    auto halo_plus(const Field<T>& f, RC center) {
-        return Halo<T, VonNeumannNeighborhood>(f, center);
+    template <typename T, typename L>
+    auto halo_plus(const Field<T, L>& f, RC center) {
+        return Halo<T, VonNeumannNeighborhood, Field<T, L>>(f, center);
     }
 
-    template <typename T>
-    auto halo_cross(const Field<T>& f, RC center) {
-        return Halo<T, DiagonalsNeighborhood>(f, center);
+    template <typename T, typename L>
+    auto halo_cross(const Field<T, L>& f, RC center) {
+        return Halo<T, DiagonalsNeighborhood, Field<T, L>>(f, center);
     }
 
-    template <typename T>
-    auto halo(const Field<T>& f, RC center) {
-        return Halo<T, MooreNeighborhood>(f, center);
+    template <typename T, typename L>
+    auto halo(const Field<T, L>& f, RC center) {
+        return Halo<T, MooreNeighborhood, Field<T, L>>(f, center);
+    }
+
+    /*
+     * Counts the neighbors of rc with pred(value), for a field with border() >= 1:
+     * no bounds checks, just a fixed set of linear offsets, unrolled.
+     */
+    template <typename Neighborhood, typename T, typename Pred>
+    index_t count_neighbors(const Field<T>& field, const RC rc, Pred&& pred) {
+        assert(field.border() >= 1);
+        const T* const center = &field[rc];
+        const auto offsets = field.template linear_offsets<Neighborhood>();
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return (index_t{0} + ... + static_cast<index_t>(pred(center[offsets[I]])));
+        }(std::make_index_sequence<offsets.size()>{});
+    }
+
+    /*
+     * One pass of op over all inner cells, row by row, into a new field (with the same
+     * border, filled with R{}): out[rc] = op(field[rc], neighbors), where neighbors is
+     * a std::array of the values at Neighborhood::offsets. The offsets are unrolled at
+     * compile time and each one is a contiguous row pointer, so the inner loop has no
+     * branches and can be vectorized. Needs border() >= 1.
+     *
+     *      auto counts = aoc::stencil<aoc::MooreNeighborhood>(field,
+     *          [](char, const auto& nb) { return static_cast<uint8_t>(std::ranges::count(nb, '@')); });
+     */
+    namespace field_detail {
+        // rows [first, last) of the row-major stencil pass, out has the same extents as field
+        template <typename Neighborhood, typename T, typename R, typename Op>
+        void stencil_rows(const Field<T>& field, Field<R>& out, const index_t first, const index_t last, Op& op) {
+            constexpr auto& offsets = Neighborhood::offsets;
+            const index_t stride = field.stride();
+            for (index_t row = first; row < last; ++row) {
+                const T* const center = field.data() + row * stride;
+                R* const dst = out.data() + row * out.stride();
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    const std::array<const T*, offsets.size()> src{ (center + offsets[I].row * stride + offsets[I].col)... };
+                    for (index_t col = 0; col < field.cols(); ++col) {
+                        const std::array<T, offsets.size()> nb{ src[I][col]... };
+                        dst[col] = op(center[col], nb);
+                    }
+                }(std::make_index_sequence<offsets.size()>{});
+            }
+        }
+    }
+
+    template <typename Neighborhood, typename T, typename L, typename Op>
+    auto stencil(const Field<T, L>& field, Op&& op) {
+        constexpr auto& offsets = Neighborhood::offsets;
+        using R = std::invoke_result_t<Op&, const T&, const std::array<T, offsets.size()>&>;
+
+        if (field.border() < 1)
+            throw std::runtime_error("stencil needs a field with border");
+
+        Field<R, L> out(field.rows(), field.cols(), field.border(), R{});
+        if constexpr (Field<T, L>::is_row_major) {
+            field_detail::stencil_rows<Neighborhood>(field, out, 0, field.rows(), op);
+        } else {
+            // other layouts: the same, but through the index translation
+            for (index_t row = 0; row < field.rows(); ++row) {
+                for (index_t col = 0; col < field.cols(); ++col) {
+                    [&]<size_t... I>(std::index_sequence<I...>) {
+                        const std::array<T, offsets.size()> nb{ field[row + offsets[I].row, col + offsets[I].col]... };
+                        out[row, col] = op(field[row, col], nb);
+                    }(std::make_index_sequence<offsets.size()>{});
+                }
+            }
+        }
+        return out;
+    }
+
+    /*
+     * Generation by generation, field = op(field) as in stencil (op gives a T again),
+     * until generations are done or one of them changes nothing. Returns the number
+     * of generations done. The rows are split into one band per thread (0 means
+     * hardware concurrency), each band is done by its own thread for all generations.
+     * Two buffers take turns as source and destination, and a barrier ends each
+     * generation, so all bands see the complete previous one. There is no copy of
+     * halo rows, a band reads the rows next to it from the shared source buffer
+     * (hence only neighborhoods within distance 1). Needs border() >= 1; op is called
+     * concurrently and must not throw.
+     */
+    template <typename Neighborhood, typename T, typename Op>
+    size_t par_generations(Field<T>& field, Op&& op, const size_t generations, size_t threads = 0) {
+        static_assert(std::ranges::all_of(Neighborhood::offsets, [](const RC o) { return o.row >= -1 && o.row <= 1 && o.col >= -1 && o.col <= 1; }),
+                      "par_generations: only neighborhoods within distance 1");
+        if (field.border() < 1)
+            throw std::runtime_error("par_generations needs a field with border");
+        if (generations == 0 || field.rows() == 0)
+            return 0;
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        const auto minRows = std::max<index_t>(1, static_cast<index_t>(par_min_part_size) / std::max<index_t>(1, field.cols()));
+        const auto bands = static_cast<index_t>(std::clamp<size_t>(static_cast<size_t>(field.rows() / minRows), 1, threads));
+
+        Field<T> other = field;                                 // the same border in both
+        std::array<Field<T>*, 2> buffers{ &field, &other };     // source, destination
+        std::vector<Padded<bool>> changed(static_cast<size_t>(bands));
+        size_t done = 0;
+        bool stop = false;
+
+        // runs once per generation, after all bands arrived and before any continues
+        auto nextGeneration = [&]() noexcept {
+            ++done;
+            std::swap(buffers[0], buffers[1]);
+            stop = done == generations || std::ranges::none_of(changed, [](const Padded<bool>& c) { return c.value; });
+        };
+        std::barrier sync(bands, nextGeneration);
+
+        auto band = [&](const index_t b) {
+            const index_t first = field.rows() * b / bands;
+            const index_t last = field.rows() * (b + 1) / bands;
+            while (!stop) {
+                const Field<T>& src = *buffers[0];
+                Field<T>& dst = *buffers[1];
+                field_detail::stencil_rows<Neighborhood>(src, dst, first, last, op);
+                bool any = false;
+                for (index_t row = first; row < last && !any; ++row)
+                    any = !std::equal(src.data() + row * src.stride(), src.data() + row * src.stride() + src.cols(),
+                                      dst.data() + row * dst.stride());
+                changed[static_cast<size_t>(b)].value = any;
+                sync.arrive_and_wait();
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(static_cast<size_t>(bands - 1));
+            for (index_t b = 1; b < bands; ++b)
+                workers.emplace_back(band, b);
+            band(0);
+        }
+        if (buffers[0] != &field)
+            field = std::move(*buffers[0]);
+        return done;
+    }
+
+    struct PeelResult {
+        int64_t firstWave;      // removed in the first round, i.e. below threshold from the start
+        int64_t total;          // removed until nothing changes anymore
+    };
+
+    /*
+     * Erosion with a worklist: a cell with alive(value) and fewer than threshold alive
+     * neighbors is removed (set to 'removed'), which may push its neighbors below the
+     * threshold, and so on. Instead of recounting everything round by round, the
+     * neighbor counts are kept in a field and only the neighbors of a removed cell are
+     * decremented, so it is O(cells) overall. As the result does not depend on the
+     * order of removals, it is the same as with rounds. Needs border() >= 1, the
+     * border must not be alive.
+     */
+    template <typename Neighborhood, typename T, typename Alive>
+    PeelResult peel(Field<T>& field, Alive&& alive, const unsigned threshold, const T& removed) {
+        auto counts = stencil<Neighborhood>(field, [&](const T&, const auto& neighbors) {
+            return static_cast<uint8_t>(std::ranges::count_if(neighbors, alive));
+        });
+        const auto offsets = field.template linear_offsets<Neighborhood>();
+        T* const cells = field.data();
+        uint8_t* const count = counts.data();       // same border, same stride
+
+        // first wave: removed right away, so no cell is queued twice
+        std::vector<std::ptrdiff_t> queue;
+        for (index_t row = 0; row < field.rows(); ++row) {
+            for (index_t col = 0; col < field.cols(); ++col) {
+                const std::ptrdiff_t i = row * field.stride() + col;
+                if (alive(cells[i]) && count[i] < threshold) {
+                    cells[i] = removed;
+                    queue.push_back(i);
+                }
+            }
+        }
+        const auto firstWave = static_cast<int64_t>(queue.size());
+
+        // all alive cells have >= threshold neighbors now, so each one drops below only once
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const std::ptrdiff_t i = queue[head];
+            for (const auto offset : offsets) {
+                const std::ptrdiff_t j = i + offset;
+                if (alive(cells[j]) && --count[j] < threshold) {
+                    cells[j] = removed;
+                    queue.push_back(j);
+                }
+            }
+        }
+        return {firstWave, static_cast<int64_t>(queue.size())};
     }
 
     /*
@@ -241,23 +708,23 @@ namespace aoc {
         for (const auto &line : lines) {
             if (line.empty()) continue;
 
-            auto v = aoc::to_numbers<T>(line);
             if (dst_row==0) {
-                if (v.empty())
+                cols = static_cast<index_t>(aoc::for_each_number<T>(line, whitespace, [](T) {}));
+                if (cols == 0)
                     throw std::runtime_error("no cols");
-                cols = static_cast<index_t>(v.size());
                 field.resize(rows, cols);
-            } else if (cols != v.size()) {
-                throw std::runtime_error("different cols");
             }
-            std::copy_n(v.begin(), cols, field.data() + dst_row * cols);
+            // straight into the row, no temporary vector
+            const std::span<T> row(field.data() + dst_row * field.stride(), static_cast<size_t>(cols));
+            if (aoc::scan_numbers<T>(line, row) != row.size())
+                throw std::runtime_error("different cols");
             ++dst_row;
         }
         return field;
     }
 
     template <std::ranges::input_range R>
-    Field<char> to_field_char_impl(R&& lines) {
+    Field<char> to_field_char_impl(R&& lines, const index_t border = 0, const char sentinel = ' ') {
         // guard: check format, count rows
         index_t rows{0};
         index_t cols{0};
@@ -268,14 +735,14 @@ namespace aoc {
         if (rows==0 || cols==0)
             throw std::runtime_error("no data");
 
-        Field<char> field(rows, cols);
+        Field<char> field(rows, cols, border, sentinel);
 
         index_t dst_row = 0;
         for (const auto &line : lines) {
             if (line.empty()) continue;
-            std::copy_n(line.begin(), line.size(), field.data() + dst_row * cols);
+            std::copy_n(line.begin(), line.size(), field.data() + dst_row * field.stride());
             if (line.size() < cols) {
-                std::fill_n(field.data() + dst_row * cols + line.size(), cols-line.size(), ' ');
+                std::fill_n(field.data() + dst_row * field.stride() + line.size(), cols-line.size(), ' ');
             }
             ++dst_row;
         }
@@ -313,6 +780,26 @@ namespace aoc {
     template <FieldElement T>
     inline constexpr ToFieldAdaptor<T> to_field{};
 
+    // like to_field<char>, but with a border ring of sentinel cells, e.g. to_padded_field('.')
+    struct ToPaddedFieldAdaptor {
+        char sentinel{' '};
+        index_t border{1};
+
+        template <std::ranges::input_range R>
+        auto operator()(R&& lines) const -> Field<char> {
+            return to_field_char_impl(std::forward<R>(lines), border, sentinel);
+        }
+
+        template <std::ranges::input_range R>
+        friend auto operator|(R&& lines, const ToPaddedFieldAdaptor& self) -> Field<char> {
+            return self(std::forward<R>(lines));
+        }
+    };
+
+    inline ToPaddedFieldAdaptor to_padded_field(const char sentinel = ' ', const index_t border = 1) {
+        return {sentinel, border};
+    }
+
     template <typename T>
     struct ToStdFieldAdaptor {
         template <std::ranges::input_range R>
@@ -0,0 +1,229 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_FLAT
+#define AOC_FLAT
+
+#include "aoc_uses.hpp"
+#include "aoc_field.hpp"
+
+namespace aoc {
+
+    // the 64-bit finalizer of splitmix64, every input bit affects every output bit
+    constexpr uint64_t mix64(uint64_t x) noexcept {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27; x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // hashes for the flat containers: integers and RC (packed into 64 bits) are mixed directly
+    template <typename T>
+    struct FlatHash {
+        size_t operator()(const T& x) const noexcept {
+            if constexpr (std::integral<T> || std::is_enum_v<T>)
+                return static_cast<size_t>(mix64(static_cast<uint64_t>(x)));
+            else
+                return static_cast<size_t>(mix64(std::hash<T>{}(x)));
+        }
+    };
+
+    template <>
+    struct FlatHash<RC> {
+        size_t operator()(const RC& rc) const noexcept {
+            return static_cast<size_t>(mix64((static_cast<uint64_t>(rc.row) << 32) ^ static_cast<uint32_t>(rc.col)));
+        }
+    };
+
+    /*
+     * Open addressing hash table with linear probing, the base of FlatMap and FlatSet.
+     * No node per entry, the keys, values and used-flags are three plain arrays
+     * (a probe mostly touches keys only). Erase shifts the following entries of the
+     * cluster back, so there are no tombstones and probes stay short.
+     * As with std::unordered_map, insert and erase invalidate iterators; in addition
+     * a rehash moves keys and values, so references do not survive an insert.
+     */
+    template <typename Key, typename Value, typename Hash = FlatHash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class FlatTable {
+        static constexpr bool isSet = std::is_void_v<Value>;
+        using mapped = std::conditional_t<isSet, char, Value>;     // char: just not void
+        struct Stored { mapped value; };                            // no vector<bool>
+        struct NoValues {};
+        using values_type = std::conditional_t<isSet, NoValues, std::vector<Stored>>;
+
+        std::vector<Key> keys_;
+        [[no_unique_address]] values_type values_;
+        std::vector<uint8_t> used_;
+        size_t size_{0};
+        size_t mask_{0};                            // capacity-1, capacity is a power of 2
+        [[no_unique_address]] Hash hash_;
+        [[no_unique_address]] KeyEqual equal_;
+
+        static constexpr size_t maxLoadNum = 3;     // at most 3/4 full
+        static constexpr size_t maxLoadDen = 4;
+
+        [[nodiscard]] size_t slot_of(const Key& key) const noexcept { return hash_(key) & mask_; }
+
+        // the slot of key, or the free slot where it would go
+        [[nodiscard]] size_t probe(const Key& key) const noexcept {
+            size_t i = slot_of(key);
+            while (used_[i] && !equal_(keys_[i], key))
+                i = (i + 1) & mask_;
+            return i;
+        }
+
+        void rehash(const size_t capacity) {
+            FlatTable other;
+            other.keys_.resize(capacity);
+            if constexpr (!isSet) other.values_.resize(capacity);
+            other.used_.assign(capacity, 0);
+            other.mask_ = capacity - 1;
+            for (size_t i = 0; i < used_.size(); ++i) {
+                if (!used_[i]) continue;
+                const size_t j = other.probe(keys_[i]);
+                other.keys_[j] = std::move(keys_[i]);
+                if constexpr (!isSet) other.values_[j] = std::move(values_[i]);
+                other.used_[j] = 1;
+            }
+            other.size_ = size_;
+            *this = std::move(other);
+        }
+
+        void grow_for(const size_t n) {
+            if (n * maxLoadDen > used_.size() * maxLoadNum)
+                rehash(std::bit_ceil(std::max<size_t>(16, (n * maxLoadDen + maxLoadNum - 1) / maxLoadNum)));
+        }
+
+    public:
+        using key_type = Key;
+        using size_type = size_t;
+        using value_type = std::conditional_t<isSet, Key, std::pair<Key, mapped>>;
+
+        template <bool Const>
+        class basic_iterator {
+            using table_type = std::conditional_t<Const, const FlatTable, FlatTable>;
+            table_type* table_{};
+            size_t idx_{0};
+
+            void skip() { while (idx_ < table_->used_.size() && !table_->used_[idx_]) ++idx_; }
+
+            friend class FlatTable;
+            template <bool> friend class basic_iterator;
+
+        public:
+            using iterator_concept  = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = FlatTable::value_type;
+            using reference         = std::conditional_t<isSet, const Key&,
+                                          std::pair<const Key&, std::conditional_t<Const, const mapped&, mapped&>>>;
+
+            basic_iterator() = default;
+            basic_iterator(table_type* table, const size_t idx) : table_(table), idx_(idx) { skip(); }
+            template <bool C = Const> requires C    // a template, so it is no copy constructor
+            basic_iterator(const basic_iterator<false>& other) : table_(other.table_), idx_(other.idx_) {}
+
+            reference operator*() const {
+                if constexpr (isSet) return table_->keys_[idx_];
+                else return {table_->keys_[idx_], table_->values_[idx_].value};
+            }
+
+            basic_iterator& operator++() { ++idx_; skip(); return *this; }
+            basic_iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const basic_iterator& other) const noexcept { return idx_ == other.idx_; } // skip the pointer test
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        FlatTable() = default;
+
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] size_t capacity() const noexcept { return used_.size() * maxLoadNum / maxLoadDen; }
+        [[nodiscard]] size_t max_size() const noexcept { return keys_.max_size() / 2; }
+
+        void reserve(const size_t n) { grow_for(n); }
+
+        void clear() noexcept {
+            std::ranges::fill(used_, 0);
+            size_ = 0;
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return {this, 0}; }
+        [[nodiscard]] iterator end() noexcept { return {this, used_.size()}; }
+        [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+        [[nodiscard]] const_iterator end() const noexcept { return {this, used_.size()}; }
+
+        [[nodiscard]] iterator find(const Key& key) noexcept {
+            if (size_ == 0) return end();
+            const size_t i = probe(key);
+            return used_[i] ? iterator{this, i} : end();
+        }
+        [[nodiscard]] const_iterator find(const Key& key) const noexcept {
+            if (size_ == 0) return end();
+            const size_t i = probe(key);
+            return used_[i] ? const_iterator{this, i} : end();
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const noexcept { return find(key) != end(); }
+        [[nodiscard]] size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+
+        // like try_emplace: the value is only constructed if key is new
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+            grow_for(size_ + 1);
+            const size_t i = probe(key);
+            if (used_[i])
+                return {iterator{this, i}, false};
+            keys_[i] = key;
+            if constexpr (!isSet) values_[i].value = Value(std::forward<Args>(args)...);
+            used_[i] = 1;
+            ++size_;
+            return {iterator{this, i}, true};
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value) {
+            if constexpr (isSet) return try_emplace(value);
+            else return try_emplace(value.first, value.second);
+        }
+
+        // the hint is ignored, it is there for std::ranges::to and std::inserter
+        iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) { return insert(value_type(std::forward<Args>(args)...)); }
+
+        // only for maps
+        template <typename V = Value> requires (!std::is_void_v<V>)
+        V& operator[](const Key& key) { return values_[try_emplace(key).first.idx_].value; }
+
+        // backward shift: entries behind the gap that may move into it do so
+        size_t erase(const Key& key) {
+            if (size_ == 0) return 0;
+            size_t i = probe(key);
+            if (!used_[i]) return 0;
+
+            for (size_t j = (i + 1) & mask_; used_[j]; j = (j + 1) & mask_) {
+                const size_t home = slot_of(keys_[j]);
+                // j may move to i if its home is not in the cyclic range (i, j]
+                if (((j - home) & mask_) >= ((j - i) & mask_)) {
+                    keys_[i] = std::move(keys_[j]);
+                    if constexpr (!isSet) values_[i] = std::move(values_[j]);
+                    i = j;
+                }
+            }
+            used_[i] = 0;
+            --size_;
+            return 1;
+        }
+    };
+
+    template <typename Key, typename Value, typename Hash = FlatHash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using FlatMap = FlatTable<Key, Value, Hash, KeyEqual>;
+
+    template <typename Key, typename Hash = FlatHash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using FlatSet = FlatTable<Key, void, Hash, KeyEqual>;
+}
+
+#endif // AOC_FLAT
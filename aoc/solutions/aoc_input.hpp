@@ -4,45 +4,186 @@
 #define AOC_INPUT
 
 #include "aoc_uses.hpp"
+#include "aoc_run.hpp"
 
 namespace aoc {
 
     using Lines = std::vector<string>;
 
+    inline string path_of(const int day) { return format("../../aoc/data/input_day{:02}.txt", day); }
+
+    /*
+     * Read-only mapping of a whole file (mmap on POSIX, a plain read elsewhere).
+     * Nothing is copied up front, the OS pages the file in on first access.
+     * See aoc.cpp.
+     */
+    class MappedFile {
+        const char* data_{};
+        size_t size_{};
+
+    public:
+        explicit MappedFile(const string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] string_view view() const noexcept { return {data_, size_}; }
+    };
+
+    struct LineSpan {
+        uint32_t offset;                // compact, limits a text to 4 GiB
+        uint32_t len;
+    };
+
+    // (offset,len) of all lines in one pass, SSE2/AVX2 for the '\n'-search if available, see aoc.cpp
+    std::vector<LineSpan> index_lines(string_view text);
+
+    /*
+     * The line table of a text, built once: one (offset,len) per line, with the same
+     * lines as split('\n'), i.e. a trailing '\n' leads to a last, empty line and an
+     * empty text has no lines. Plus the boundaries of the blocks, the maximal runs of
+     * non-empty lines.
+     * It is a random-access range of string_view, so line n is just index[n].
+     * The owner, if given, keeps the storage of the text alive as long as the index
+     * (and thus any view of its lines) lives.
+     */
+    class LineIndex {
+        string_view text_;
+        std::shared_ptr<const void> owner_;
+        std::vector<LineSpan> lines_;
+        std::vector<std::pair<size_t, size_t>> blocks_;    // [first, last) line numbers
+
+    public:
+        class iterator {
+            const char* text_{};
+            const LineSpan* span_{};
+
+        public:
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;  // reference is no real reference
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = string_view;
+            using reference         = string_view;
+
+            iterator() = default;
+
+            iterator(const char* text, const LineSpan* span) : text_(text), span_(span) {}
+
+            string_view operator*() const noexcept { return {text_ + span_->offset, span_->len}; }
+            string_view operator[](const difference_type n) const noexcept { return *(*this + n); }
+
+            iterator& operator++() noexcept { ++span_; return *this; }
+            iterator& operator--() noexcept { --span_; return *this; }
+            iterator operator++(int) noexcept { auto tmp = *this; ++span_; return tmp; }
+            iterator operator--(int) noexcept { auto tmp = *this; --span_; return tmp; }
+
+            iterator& operator+=(const difference_type n) noexcept { span_ += n; return *this; }
+            iterator& operator-=(const difference_type n) noexcept { span_ -= n; return *this; }
+            friend iterator operator+(iterator it, const difference_type n) noexcept { return it += n; }
+            friend iterator operator+(const difference_type n, iterator it) noexcept { return it += n; }
+            friend iterator operator-(iterator it, const difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const iterator& a, const iterator& b) noexcept { return a.span_ - b.span_; }
+
+            bool operator==(const iterator& other) const noexcept { return span_ == other.span_; }
+            auto operator<=>(const iterator& other) const noexcept { return span_ <=> other.span_; }
+        };
+
+        explicit LineIndex(string_view text, std::shared_ptr<const void> owner = {});   // see aoc.cpp
+
+        [[nodiscard]] iterator begin() const noexcept { return {text_.data(), lines_.data()}; }
+        [[nodiscard]] iterator end()   const noexcept { return {text_.data(), lines_.data() + lines_.size()}; }
+        [[nodiscard]] size_t size() const noexcept { return lines_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return lines_.empty(); }
+
+        string_view operator[](const size_t n) const noexcept { return begin()[static_cast<std::ptrdiff_t>(n)]; }
+
+        [[nodiscard]] string_view text() const noexcept { return text_; }
+        [[nodiscard]] const std::vector<LineSpan>& spans() const noexcept { return lines_; }
+        [[nodiscard]] const std::vector<std::pair<size_t, size_t>>& blocks() const noexcept { return blocks_; }
+    };
+
+    /*
+     * The text of an input, read-only. Owned or mapped, the storage is shared (by
+     * copies of the Input and by its LineIndex), so it never moves and the line views
+     * stay valid even after the Input itself is gone, e.g. Input::of(day) | as_line_views.
+     */
     class Input {
         using storage_type = string;
-        storage_type text_;
+        std::shared_ptr<const storage_type> text_;
+        std::shared_ptr<const MappedFile> mapped_;  // if set, text_ is unused
+
+        // built on first use and shared by all copies, line and block views (not thread-safe)
+        std::shared_ptr<std::shared_ptr<const LineIndex>> lines_{std::make_shared<std::shared_ptr<const LineIndex>>()};
+
+        [[nodiscard]] std::shared_ptr<const void> storage() const noexcept {
+            if (mapped_) return mapped_;
+            return text_;
+        }
 
     public:
+        // Owned copies the file into text_, Mapped hands out views into the mapped pages.
+        enum class Storage { Owned, Mapped };
+
         using value_type     = char;
         using size_type      = size_t;
-        using iterator       = storage_type::const_iterator;
-        using const_iterator = storage_type::const_iterator;
+        using iterator       = string_view::const_iterator;
+        using const_iterator = string_view::const_iterator;
 
         Input() = default;
 
-        explicit Input(storage_type s) : text_(std::move(s)) {}
+        explicit Input(storage_type s) : text_(std::make_shared<const storage_type>(std::move(s))) {}
+
+        explicit Input(std::shared_ptr<const MappedFile> mapped) : mapped_(std::move(mapped)) {}
 
         // construct from iterator range if you ever need it
         template <std::input_iterator It, std::sentinel_for<It> Sent>
-        Input(It first, Sent last) : text_(first, last) {}
+        Input(It first, Sent last) : text_(std::make_shared<const storage_type>(first, last)) {}
 
-        [[nodiscard]] const_iterator begin() const noexcept { return text_.begin(); }
-        [[nodiscard]] const_iterator end()   const noexcept { return text_.end();   }
-        [[nodiscard]] bool empty()  const noexcept          { return text_.empty(); }
-        [[nodiscard]] size_type size() const noexcept       { return text_.size();  }
+        [[nodiscard]] const_iterator begin() const noexcept { return view().begin(); }
+        [[nodiscard]] const_iterator end()   const noexcept { return view().end();   }
+        [[nodiscard]] bool empty()  const noexcept          { return view().empty(); }
+        [[nodiscard]] size_type size() const noexcept       { return view().size();  }
 
         //[[nodiscard]] storage_type data() const noexcept { return text_; }
         //const value_type& operator[](size_type i) const { return text_[i]; }
 
-        [[nodiscard]] string_view view() const noexcept { return string_view(text_); }
+        [[nodiscard]] string_view view() const noexcept {
+            if (mapped_) return mapped_->view();
+            return text_ ? string_view(*text_) : string_view{};
+        }
+
+        [[nodiscard]] std::shared_ptr<const LineIndex> line_index() const {
+            if (!*lines_)
+                *lines_ = std::make_shared<const LineIndex>(view(), storage());
+            return *lines_;
+        }
+
+        // the input of this run, its lines are only counted (indexed) if counters are printed
+        void register_run() const {
+            run_info().inputBytes = size();
+            run_info().inputLines = [input = *this] { return input.line_index()->size(); };
+        }
 
         // factories
 
-        static Input of(const string& example) { return Input(example); }
+        static Input of(const string& example) {
+            Input input(example);
+            input.register_run();
+            return input;
+        }
 
-        static Input of(int day) {
-            std::ifstream in(format("../../aoc/data/input_day{:02}.txt", day));
+        static Input of(const int day, const Storage storage = Storage::Mapped) {
+            auto input = from_file(path_of(day), storage);
+            input.register_run();
+            return input;
+        }
+
+        static Input from_file(const string& path, const Storage storage = Storage::Mapped) {
+            if (storage == Storage::Mapped)
+                return Input(std::make_shared<const MappedFile>(path));
+
+            std::ifstream in(path);
             if (!in) throw std::runtime_error("cannot open file");
 
             std::ostringstream ss;
@@ -51,6 +192,110 @@ namespace aoc {
         }
     };
 
+    /*
+     * The lines of a file without holding the whole file: it is read in chunks into
+     * one buffer, and the incomplete line at the end of a chunk is moved to the front
+     * before the next read. So no line spans two chunks, and the memory is about one
+     * chunk (the buffer only grows for a single line longer than that).
+     * Single pass, a line is valid until the next one is read. Same lines as
+     * as_line_views, i.e. a trailing '\n' gives a last, empty line.
+     */
+    class LineStream : public std::ranges::view_interface<LineStream> {
+        // the state is shared by all copies, it is a single pass anyway
+        class Reader {
+            std::ifstream in_;
+            std::vector<char> buffer_;
+            size_t pos_{0};                 // unread data is [pos_, end_)
+            size_t end_{0};
+            bool pendingEmpty_{false};      // last line ended with '\n', one empty line to go
+
+            bool fill() {
+                if (!in_) return false;
+                if (pos_ > 0) {             // keep the incomplete line, move it to the front
+                    std::copy(buffer_.begin() + pos_, buffer_.begin() + end_, buffer_.begin());
+                    end_ -= pos_;
+                    pos_ = 0;
+                }
+                if (end_ == buffer_.size())
+                    buffer_.resize(2 * buffer_.size());
+                in_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+                const auto count = static_cast<size_t>(in_.gcount());
+                end_ += count;
+                return count > 0;
+            }
+
+        public:
+            bool done{false};
+            string_view line;
+
+            Reader(const string& path, const size_t chunkSize)
+                : in_(path, std::ios::binary), buffer_(std::max<size_t>(chunkSize, 1)) {
+                if (!in_) throw std::runtime_error("cannot open file");
+            }
+
+            void next() {
+                size_t from = pos_;         // no need to search the old part again
+                while (true) {
+                    if (const auto nl = static_cast<const char*>(std::memchr(buffer_.data() + from, '\n', end_ - from))) {
+                        const auto at = static_cast<size_t>(nl - buffer_.data());
+                        line = {buffer_.data() + pos_, at - pos_};
+                        pos_ = at + 1;
+                        pendingEmpty_ = true;
+                        return;
+                    }
+                    from = end_ - pos_;     // offset after the move to the front
+                    if (!fill()) break;
+                }
+                if (pos_ < end_) {          // last line without '\n'
+                    line = {buffer_.data() + pos_, end_ - pos_};
+                    pos_ = end_;
+                    pendingEmpty_ = false;
+                } else if (pendingEmpty_) {
+                    line = {};
+                    pendingEmpty_ = false;
+                } else {
+                    done = true;
+                }
+            }
+        };
+
+        std::shared_ptr<Reader> reader_;
+
+    public:
+        static constexpr size_t defaultChunkSize = 1 << 20;
+
+        explicit LineStream(const string& path, const size_t chunkSize = defaultChunkSize)
+            : reader_(std::make_shared<Reader>(path, chunkSize)) {}
+
+        static LineStream of(const int day, const size_t chunkSize = defaultChunkSize) {
+            return LineStream(path_of(day), chunkSize);
+        }
+
+        // To use the iterator with ranges-algorithms, it must fulfill the range-requirements.
+        class iterator {
+            Reader* reader_{};
+
+        public:
+            using iterator_concept  = std::input_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = string_view;
+
+            iterator() = default;
+
+            explicit iterator(Reader& reader) : reader_(&reader) {}
+
+            string_view operator*() const noexcept { return reader_->line; }
+
+            iterator& operator++() { reader_->next(); return *this; }
+            void operator++(int) { ++*this; }
+
+            bool operator==(std::default_sentinel_t) const noexcept { return reader_->done; }
+        };
+
+        [[nodiscard]] iterator begin() const { reader_->next(); return iterator(*reader_); }
+        [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+    };
+
     // input adapter
 
     constexpr string_view trim(const string_view sv) noexcept {
@@ -70,27 +315,82 @@ namespace aoc {
     }
 
     /*
-     * One note here: converting them into string_view makes it more convenient
-     * in some cases but limits the usage (split returns a range on chars, which is
-     * more flexible, i.e. for a transpose view).
+     * A range of lines [first, last) of a LineIndex as a random-access view of
+     * string_views, it keeps the index alive.
+     * One note here: string_views are more convenient than the char ranges of a
+     * split, but limit the usage (i.e. for a transpose view).
      */
+    class LineViews : public std::ranges::view_interface<LineViews> {
+        std::shared_ptr<const LineIndex> index_;
+        size_t first_{0};
+        size_t last_{0};
+
+    public:
+        using iterator = LineIndex::iterator;
+
+        LineViews() = default;
 
-    inline constexpr auto as_line_views =
-        std::views::split('\n')
-      | std::views::transform([](auto&& sub) -> string_view {
-            auto first = sub.begin();
-            auto last  = sub.end();
-            if (first == last) { return {}; }
+        explicit LineViews(std::shared_ptr<const LineIndex> index)
+            : index_(std::move(index)), last_(index_->size()) {}
 
-            auto ptr = std::to_address(first);
-            auto len = static_cast<size_t>(std::ranges::distance(first, last));
-            return {ptr, len};
-        });
+        LineViews(std::shared_ptr<const LineIndex> index, const size_t first, const size_t last)
+            : index_(std::move(index)), first_(first), last_(last) {}
 
-    inline constexpr auto as_block_views =
-        as_line_views
-      | std::views::split(std::array{string_view{}})
-      | std::views::filter([](auto&& block) { return !std::ranges::empty(block); });
+        [[nodiscard]] iterator begin() const noexcept { return index_ ? index_->begin() + static_cast<std::ptrdiff_t>(first_) : iterator(); }
+        [[nodiscard]] iterator end()   const noexcept { return index_ ? index_->begin() + static_cast<std::ptrdiff_t>(last_) : iterator(); }
+
+        // line numbers within the index
+        [[nodiscard]] size_t first() const noexcept { return first_; }
+        [[nodiscard]] size_t last()  const noexcept { return last_; }
+
+        // k consecutive parts with about the same number of bytes (some may be empty), see aoc.cpp
+        [[nodiscard]] std::vector<LineViews> partition(size_t k) const;
+    };
+
+    // the index of an Input is cached by the Input (and keeps its text alive), any other text gets its own
+    inline std::shared_ptr<const LineIndex> line_index_of(const Input& input) { return input.line_index(); }
+
+    template <std::ranges::contiguous_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, char> && std::ranges::borrowed_range<R>
+              && (!std::same_as<std::remove_cvref_t<R>, Input>)
+    std::shared_ptr<const LineIndex> line_index_of(R&& r) {
+        return std::make_shared<const LineIndex>(string_view(std::ranges::data(r), std::ranges::size(r)));
+    }
+
+    template <typename R>
+    concept LineSource = requires (R&& r) { line_index_of(std::forward<R>(r)); };
+
+    struct AsLineViewsAdaptor {
+        template <LineSource R>
+        LineViews operator()(R&& r) const { return LineViews(line_index_of(std::forward<R>(r))); }
+
+        template <LineSource R>
+        friend LineViews operator|(R&& r, const AsLineViewsAdaptor& self) {
+            return self(std::forward<R>(r));
+        }
+    };
+
+    inline constexpr AsLineViewsAdaptor as_line_views{};
+
+    // the blocks, from the precomputed boundaries, as random-access range of LineViews
+    struct AsBlockViewsAdaptor {
+        template <LineSource R>
+        auto operator()(R&& r) const {
+            auto index = line_index_of(std::forward<R>(r));
+            return std::views::iota(size_t{0}, index->blocks().size())
+                | std::views::transform([index](const size_t b) {
+                      const auto [first, last] = index->blocks()[b];
+                      return LineViews(index, first, last);
+                  });
+        }
+
+        template <LineSource R>
+        friend auto operator|(R&& r, const AsBlockViewsAdaptor& self) {
+            return self(std::forward<R>(r));
+        }
+    };
+
+    inline constexpr AsBlockViewsAdaptor as_block_views{};
 
     inline constexpr auto first_block_view =
         std::views::drop_while([](auto const& s) { return s.empty(); })
@@ -102,7 +402,24 @@ namespace aoc {
     //| std::views::transform([](string_view sv) { return string(sv); })
       | std::ranges::to<Lines>();
 
-    inline constexpr auto as_std_lines = as_line_views | first_block_view;
+    // same as as_line_views | first_block_view, but straight from the block boundaries
+    struct AsStdLinesAdaptor {
+        template <LineSource R>
+        LineViews operator()(R&& r) const {
+            auto index = line_index_of(std::forward<R>(r));
+            if (index->blocks().empty())
+                return {index, 0, 0};
+            const auto [first, last] = index->blocks().front();
+            return {index, first, last};
+        }
+
+        template <LineSource R>
+        friend LineViews operator|(R&& r, const AsStdLinesAdaptor& self) {
+            return self(std::forward<R>(r));
+        }
+    };
+
+    inline constexpr AsStdLinesAdaptor as_std_lines{};
 
 }
 
@@ -0,0 +1,134 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_MEMO
+#define AOC_MEMO
+
+#include "aoc_uses.hpp"
+#include "aoc_flat.hpp"
+#include "aoc_parallel.hpp"
+
+namespace aoc {
+
+    /*
+     * A thread-safe cache of compute(key), e.g. for memoized helpers called from a
+     * parallel solver:
+     *  - integral keys in [0, dense) are slots of an array, computed once each on
+     *    first use (call_once), a hit is an index and an atomic load,
+     *  - all other keys go to one of several shards, each a FlatMap with its own
+     *    lock, so threads with different keys rarely wait for each other,
+     *  - with a capacity, each shard keeps at most capacity/shards entries and drops
+     *    the least recently used one.
+     * compute runs without a lock held, so it may use the memo itself (recursion);
+     * if two threads compute the same key, the first result is kept.
+     * memo(key) returns a reference, which stays valid, so it is only allowed without
+     * a capacity; get(key) returns a copy (taken under the lock) and works with both.
+     *
+     *      aoc::memo<size_t, int64_t> fib{[&](size_t n) { return n < 2 ? n : fib(n-1) + fib(n-2); }, {.dense = 100}};
+     */
+    template <typename Key, typename Value, typename Hash = FlatHash<Key>>
+    class memo {
+    public:
+        struct Options {
+            size_t dense{0};            // only for integral keys
+            size_t capacity{0};         // 0 means unbounded
+            size_t shards{16};
+        };
+
+    private:
+        struct Slot {
+            std::once_flag once;
+            Value value{};
+        };
+
+        struct alignas(cache_line_size) Shard {
+            std::mutex mutex;
+            std::list<std::pair<Key, Value>> entries;       // stable, most recently used first
+            FlatMap<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+        };
+
+        std::function<Value(const Key&)> compute_;
+        size_t dense_;
+        size_t shardCapacity_;
+        size_t shardCount_;
+        std::unique_ptr<Slot[]> slots_;
+        std::unique_ptr<Shard[]> shards_;
+        [[no_unique_address]] Hash hash_;
+
+        [[nodiscard]] bool is_dense(const Key& key) const noexcept requires std::integral<Key> {
+            return key >= Key{0} && static_cast<size_t>(key) < dense_;
+        }
+
+        // the high bits, the low ones choose the slot in the FlatMap of the shard
+        [[nodiscard]] Shard& shard_of(const Key& key) const noexcept {
+            return shards_[(static_cast<uint64_t>(hash_(key)) >> 32) % shardCount_];
+        }
+
+        // Result is const Value& or Value; a Value is copied while the shard is locked
+        template <typename Result>
+        Result lookup(const Key& key) {
+            if constexpr (std::integral<Key>) {
+                if (is_dense(key)) {
+                    Slot& slot = slots_[static_cast<size_t>(key)];
+                    std::call_once(slot.once, [&] { slot.value = compute_(key); });
+                    return slot.value;
+                }
+            }
+
+            Shard& shard = shard_of(key);
+            {
+                std::lock_guard lock(shard.mutex);
+                if (const auto it = shard.index.find(key); it != shard.index.end()) {
+                    const auto entry = (*it).second;
+                    if (shardCapacity_ > 0)
+                        shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+                    return entry->second;
+                }
+            }
+
+            Value value = compute_(key);
+
+            std::lock_guard lock(shard.mutex);
+            if (const auto it = shard.index.find(key); it != shard.index.end())
+                return (*it).second->second;            // computed by another thread meanwhile
+            shard.entries.emplace_front(key, std::move(value));
+            shard.index.try_emplace(key, shard.entries.begin());
+            if (shardCapacity_ > 0 && shard.entries.size() > shardCapacity_) {
+                shard.index.erase(shard.entries.back().first);
+                shard.entries.pop_back();
+            }
+            return shard.entries.front().second;
+        }
+
+    public:
+        explicit memo(std::function<Value(const Key&)> compute, const Options options = {})
+            : compute_(std::move(compute)), dense_(std::integral<Key> ? options.dense : 0),
+              shardCapacity_(options.capacity == 0 ? 0 : std::max<size_t>(1, (options.capacity + options.shards - 1) / std::max<size_t>(1, options.shards))),
+              shardCount_(std::max<size_t>(1, options.shards)),
+              slots_(std::make_unique<Slot[]>(dense_)), shards_(std::make_unique<Shard[]>(shardCount_)) {}
+
+        memo(const memo&) = delete;
+        memo& operator=(const memo&) = delete;
+
+        // a reference into the cache, so only for memos without capacity (nothing is dropped)
+        const Value& operator()(const Key& key) {
+            if (shardCapacity_ > 0)
+                throw std::runtime_error("memo: with a capacity, entries may be dropped, use get()");
+            return lookup<const Value&>(key);
+        }
+
+        // a copy, safe with a capacity, too
+        [[nodiscard]] Value get(const Key& key) { return lookup<Value>(key); }
+
+        // the entries of the shards, the dense slots are not counted
+        [[nodiscard]] size_t size() const {
+            size_t n = 0;
+            for (size_t i = 0; i < shardCount_; ++i) {
+                std::lock_guard lock(shards_[i].mutex);
+                n += shards_[i].entries.size();
+            }
+            return n;
+        }
+    };
+}
+
+#endif // AOC_MEMO
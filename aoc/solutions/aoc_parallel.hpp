@@ -0,0 +1,200 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_PARALLEL
+#define AOC_PARALLEL
+
+#include "aoc_uses.hpp"
+#include "aoc_input.hpp"
+
+namespace aoc {
+
+    /*
+     * A fixed set of worker threads, started once and reused, so a parallel fold
+     * does not pay for thread creation. run(n, task) calls task(0..n-1) on the
+     * workers and the calling thread and returns when all are done; the first
+     * exception of a task is rethrown in the caller.
+     * A run from inside a task (or while another run is active) is done by the
+     * calling thread alone, so nesting cannot deadlock.
+     */
+    class ThreadPool {
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        std::mutex runMutex_;                   // one run at a time
+
+        const std::function<void(size_t)>* task_{nullptr};
+        size_t tasks_{0};
+        std::atomic<size_t> next_{0};
+        size_t finished_{0};                    // workers done with the current generation
+        size_t generation_{0};
+        bool stop_{false};
+        std::exception_ptr error_;
+
+        void work();
+        void drain();
+
+    public:
+        // threads includes the calling thread, 0 means hardware concurrency; see aoc.cpp
+        explicit ThreadPool(size_t threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] size_t size() const noexcept { return workers_.size() + 1; }
+
+        void run(size_t tasks, const std::function<void(size_t)>& task);
+
+        // the one used by default, started on first use
+        static ThreadPool& shared();
+
+        // the OS thread ids of the workers of all pools (Linux, else empty), e.g. for PerfCounters
+        static std::vector<int> worker_ids();
+    };
+
+    // keeps per-thread accumulators in their own cache lines, no false sharing
+    inline constexpr size_t cache_line_size = 64;
+
+    template <typename T>
+    struct alignas(cache_line_size) Padded {
+        T value;
+    };
+
+    // below this number of elements per part, threads cost more than they bring
+    inline constexpr size_t par_min_part_size = 4096;
+
+    namespace par_detail {
+
+        // lines are split by bytes, everything else by count
+        template <typename R>
+        auto partition(R&& r, const size_t k) {
+            if constexpr (std::same_as<std::remove_cvref_t<R>, LineViews>) {
+                return r.partition(k);
+            } else {
+                const auto n = std::ranges::size(r);
+                std::vector<std::ranges::subrange<std::ranges::iterator_t<R>>> parts;
+                parts.reserve(k);
+                for (size_t i = 0; i < k; ++i) {
+                    const auto first = std::ranges::begin(r) + static_cast<std::ptrdiff_t>(n * i / k);
+                    const auto last = std::ranges::begin(r) + static_cast<std::ptrdiff_t>(n * (i + 1) / k);
+                    parts.emplace_back(first, last);
+                }
+                return parts;
+            }
+        }
+    }
+
+    /*
+     * reduce(init, map(e)...) over a random-access range, in parts on the thread pool.
+     * Each part is folded into its own accumulator starting at init, the accumulators
+     * are merged in order at the end. So init must be neutral for reduce, and reduce
+     * must be associative (not commutative). Small ranges are folded right here.
+     *
+     *      auto sum = aoc::par_transform_reduce(lines, int64_t{0}, std::plus{}, [](string_view line) { ... });
+     */
+    template <std::ranges::random_access_range R, typename T, typename Reduce, typename Map>
+        requires std::ranges::sized_range<R>
+    T par_transform_reduce(R&& r, T init, Reduce reduce, Map map, ThreadPool& pool = ThreadPool::shared()) {
+        const size_t n = std::ranges::size(r);
+        const size_t k = std::min(pool.size(), n / par_min_part_size);
+
+        auto fold = [&](auto&& part, T acc) {
+            for (auto&& e : part)
+                acc = reduce(std::move(acc), map(e));
+            return acc;
+        };
+        if (k <= 1)
+            return fold(r, std::move(init));
+
+        const auto parts = par_detail::partition(r, k);
+        std::vector<Padded<T>> accs(k, Padded<T>{init});
+        pool.run(k, [&](const size_t i) { accs[i].value = fold(parts[i], std::move(accs[i].value)); });
+
+        for (auto& acc : accs)
+            init = reduce(std::move(init), std::move(acc.value));
+        return init;
+    }
+
+    template <typename T, typename Reduce, typename Map>
+    struct ParFoldAdaptor {
+        T init;
+        Reduce reduce;
+        Map map;
+
+        template <std::ranges::random_access_range R>
+            requires std::ranges::sized_range<R>
+        T operator()(R&& r) const { return par_transform_reduce(std::forward<R>(r), init, reduce, map); }
+
+        // Enables: lines | par_fold(init, reduce, map)
+        template <std::ranges::random_access_range R>
+            requires std::ranges::sized_range<R>
+        friend T operator|(R&& r, const ParFoldAdaptor& self) { return self(std::forward<R>(r)); }
+    };
+
+    template <typename T, typename Reduce, typename Map>
+    ParFoldAdaptor<T, Reduce, Map> par_fold(T init, Reduce reduce, Map map) {
+        return {std::move(init), std::move(reduce), std::move(map)};
+    }
+
+    /*
+     * Stable LSD radix sort by an unsigned 64-bit key(value), 8 bits per pass, and
+     * only as many passes as the largest key needs. Each pass counts the digits per
+     * part (on the thread pool), turns the counts into write positions in the order
+     * (digit, part), and each part scatters its values to its positions. As parts
+     * and the values within a part keep their order, no merge is needed.
+     *
+     *      aoc::par_radix_sort(pairs, [](const PointPair& p) { return static_cast<uint64_t>(p.dist); });
+     */
+    template <typename T, typename Key>
+    void par_radix_sort(std::vector<T>& values, Key key, ThreadPool& pool = ThreadPool::shared()) {
+        constexpr unsigned digitBits = 8;
+        constexpr size_t digits = size_t{1} << digitBits;
+
+        const size_t n = values.size();
+        if (n < 2)
+            return;
+        const size_t k = std::clamp<size_t>(n / par_min_part_size, 1, pool.size());
+        auto first = [&](const size_t part) { return n * part / k; };
+
+        std::vector<Padded<uint64_t>> maxima(k);
+        pool.run(k, [&](const size_t part) {
+            uint64_t m = 0;
+            for (size_t i = first(part); i < first(part + 1); ++i)
+                m = std::max<uint64_t>(m, key(values[i]));
+            maxima[part].value = m;
+        });
+        const uint64_t maxKey = std::ranges::max(maxima, {}, [](const Padded<uint64_t>& m) { return m.value; }).value;
+        const auto passes = (static_cast<unsigned>(std::bit_width(maxKey)) + digitBits - 1) / digitBits;
+
+        std::vector<T> buffer(n);
+        std::vector<std::array<size_t, digits>> offsets(k);
+        for (unsigned pass = 0; pass < passes; ++pass) {
+            const unsigned shift = pass * digitBits;
+            pool.run(k, [&](const size_t part) {
+                auto& count = offsets[part];
+                count.fill(0);
+                for (size_t i = first(part); i < first(part + 1); ++i)
+                    ++count[(key(values[i]) >> shift) & (digits - 1)];
+            });
+
+            size_t sum = 0;
+            for (size_t digit = 0; digit < digits; ++digit) {
+                for (auto& count : offsets) {
+                    const size_t c = count[digit];
+                    count[digit] = sum;
+                    sum += c;
+                }
+            }
+
+            pool.run(k, [&](const size_t part) {
+                auto& next = offsets[part];
+                for (size_t i = first(part); i < first(part + 1); ++i)
+                    buffer[next[(key(values[i]) >> shift) & (digits - 1)]++] = std::move(values[i]);
+            });
+            values.swap(buffer);
+        }
+    }
+}
+
+#endif // AOC_PARALLEL
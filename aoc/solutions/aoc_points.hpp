@@ -0,0 +1,264 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_POINTS
+#define AOC_POINTS
+
+#include "aoc_uses.hpp"
+#include "aoc_parallel.hpp"
+
+namespace aoc {
+
+    // 3D-stuff, points in space, e.g. day08
+
+    struct Point3 {
+        int64_t x{}, y{}, z{};
+
+        bool operator==(const Point3&) const noexcept = default;
+    };
+
+    // the squared distance, enough for comparisons
+    constexpr int64_t dist2(const Point3& a, const Point3& b) noexcept {
+        const int64_t dx = a.x - b.x;
+        const int64_t dy = a.y - b.y;
+        const int64_t dz = a.z - b.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    template <typename P>
+    concept Point3Like = requires(const P& p) {
+        { p.x } -> std::convertible_to<int64_t>;
+        { p.y } -> std::convertible_to<int64_t>;
+        { p.z } -> std::convertible_to<int64_t>;
+    };
+
+    // two point indices, i < j, and their squared distance; ordered by (dist, i, j)
+    struct PointPair {
+        uint32_t i{}, j{};
+        int64_t dist{};
+
+        bool operator==(const PointPair&) const noexcept = default;
+        friend auto operator<=>(const PointPair& a, const PointPair& b) noexcept {
+            return std::tie(a.dist, a.i, a.j) <=> std::tie(b.dist, b.i, b.j);
+        }
+    };
+
+    // an allocator for cache line (and SIMD register) aligned arrays
+    template <typename T, size_t Align = cache_line_size>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        AlignedAllocator() = default;
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+        template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+        T* allocate(const size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align})); }
+        void deallocate(T* p, size_t) noexcept { ::operator delete(p, std::align_val_t{Align}); }
+
+        friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) noexcept { return true; }
+    };
+
+    /*
+     * Points in space as structure of arrays, the x, y and z coordinates each in an
+     * aligned array of their own, so a kernel over many points reads three streams
+     * and compiles to SIMD code. Without wider instruction sets (AVX-512) there is no
+     * vector multiply of 64-bit integers, so the coordinates are kept as doubles in
+     * addition if that is exact, i.e. all |coordinate| <= 2^24 and thus all squared
+     * distances < 2^52; then the distances are computed in double lanes and turned
+     * into integers by the 2^52 trick (adding 2^52 puts the integer into the mantissa
+     * bits). Otherwise the kernel uses 64-bit integer lanes.
+     */
+    class Points3 {
+        template <typename T> using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+        static constexpr int64_t max_exact = int64_t{1} << 24;
+
+        aligned_vector<int64_t> x_, y_, z_;
+        aligned_vector<double> dx_, dy_, dz_;   // empty if not exact
+
+    public:
+        Points3() = default;
+
+        template <std::ranges::input_range R> requires Point3Like<std::ranges::range_value_t<R>>
+        explicit Points3(R&& points) {
+            if constexpr (std::ranges::sized_range<R>) {
+                x_.reserve(std::ranges::size(points)); y_.reserve(x_.capacity()); z_.reserve(x_.capacity());
+            }
+            bool exact = true;
+            for (const auto& p : points) {
+                x_.push_back(static_cast<int64_t>(p.x)); y_.push_back(static_cast<int64_t>(p.y)); z_.push_back(static_cast<int64_t>(p.z));
+                for (const int64_t c : {x_.back(), y_.back(), z_.back()})
+                    exact = exact && c >= -max_exact && c <= max_exact;
+            }
+            if (exact) {
+                dx_.assign(x_.begin(), x_.end()); dy_.assign(y_.begin(), y_.end()); dz_.assign(z_.begin(), z_.end());
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return x_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return x_.empty(); }
+        [[nodiscard]] bool double_lanes() const noexcept { return !dx_.empty() || x_.empty(); }
+
+        [[nodiscard]] Point3 operator[](const size_t i) const noexcept { return {x_[i], y_[i], z_[i]}; }
+
+        /*
+         * The squared distances from point i to the points i+1..n-1, out[k] is the one
+         * to point i+1+k; out needs room for size()-i-1 values.
+         */
+        void distances_from(const size_t i, std::span<int64_t> out) const noexcept {
+            const size_t n = size();
+            assert(i < n);
+            const size_t count = n - i - 1;
+            assert(out.size() >= count);
+            int64_t* const dist = out.data();
+            if (!dx_.empty()) {
+                const double* const x = dx_.data();
+                const double* const y = dy_.data();
+                const double* const z = dz_.data();
+                const double px = x[i], py = y[i], pz = z[i];
+                constexpr double magic = 0x1p52;
+                constexpr auto magicBits = std::bit_cast<int64_t>(magic);
+                for (size_t k = 0; k < count; ++k) {
+                    const size_t j = i + 1 + k;
+                    const double dx = x[j] - px, dy = y[j] - py, dz = z[j] - pz;
+                    dist[k] = std::bit_cast<int64_t>(dx * dx + dy * dy + dz * dz + magic) - magicBits;
+                }
+            } else {
+                const int64_t* const x = x_.data();
+                const int64_t* const y = y_.data();
+                const int64_t* const z = z_.data();
+                const int64_t px = x[i], py = y[i], pz = z[i];
+                for (size_t k = 0; k < count; ++k) {
+                    const size_t j = i + 1 + k;
+                    const int64_t dx = x[j] - px, dy = y[j] - py, dz = z[j] - pz;
+                    dist[k] = dx * dx + dy * dy + dz * dz;
+                }
+            }
+        }
+    };
+
+    /*
+     * All n(n-1)/2 pairs i < j, in parallel. The pairs of row i (with all j > i) start
+     * at i*n - i(i+1)/2, so the triangle is cut into blocks of whole rows with about
+     * the same number of pairs each, and every block writes straight into its own
+     * slice of the result. A few blocks per thread even out the load. The distances
+     * of a row come from the SIMD kernel of Points3.
+     */
+    template <std::ranges::random_access_range R> requires Point3Like<std::ranges::range_value_t<R>>
+    std::vector<PointPair> all_pairs(const R& points, ThreadPool& pool = ThreadPool::shared()) {
+        const auto n = static_cast<size_t>(std::ranges::size(points));
+        if (n > std::numeric_limits<uint32_t>::max())
+            throw std::runtime_error("all_pairs: too many points");
+        const size_t total = n * (n - std::min<size_t>(n, 1)) / 2;
+        auto rowStart = [n](const size_t i) { return i * n - i * (i + 1) / 2; };
+
+        const Points3 soa(points);
+        std::vector<PointPair> pairs(total);
+        const size_t blocks = std::clamp<size_t>(total / par_min_part_size, 1, 4 * pool.size());
+        pool.run(blocks, [&](const size_t block) {
+            // the first row starting at or after the block's share of pairs; n-1 after the last
+            // block (rowStart(n-1) == total), so row n-1 is never visited, it has no pairs anyway
+            auto firstRow = [&](const size_t b) {
+                const size_t target = total * b / blocks;
+                size_t lo = 0, hi = n;
+                while (lo < hi) {
+                    const size_t mid = lo + (hi - lo) / 2;
+                    if (rowStart(mid) < target) lo = mid + 1; else hi = mid;
+                }
+                return lo;
+            };
+            std::vector<int64_t> dist(n);
+            size_t k = rowStart(firstRow(block));
+            for (size_t i = firstRow(block); i < firstRow(block + 1); ++i) {
+                soa.distances_from(i, dist);
+                for (size_t j = i + 1; j < n; ++j)
+                    pairs[k++] = PointPair{static_cast<uint32_t>(i), static_cast<uint32_t>(j), dist[j - i - 1]};
+            }
+        });
+        return pairs;
+    }
+
+    // all pairs by (dist, i, j): generated in (i, j) order, then a stable radix sort by dist
+    template <std::ranges::random_access_range R> requires Point3Like<std::ranges::range_value_t<R>>
+    std::vector<PointPair> sorted_pairs(const R& points, ThreadPool& pool = ThreadPool::shared()) {
+        auto pairs = all_pairs(points, pool);
+        par_radix_sort(pairs, [](const PointPair& p) { return static_cast<uint64_t>(p.dist); }, pool);
+        return pairs;
+    }
+
+    /*
+     * All pairs of points by increasing distance, lazily: only as many pairs as are
+     * taken are ever looked at, instead of generating and sorting all n(n-1)/2.
+     * The points are put into a uniform grid (about two per cell). Each point i has a
+     * cursor over its partners j > i: a heap of the candidates found so far, from the
+     * cells in rings around its own cell. The smallest candidate is certain once it is
+     * closer than the distance to the border of the scanned cube, otherwise the next
+     * ring is scanned. A global heap holds the certain head of each cursor, so its top
+     * is the next pair overall. Part 1 of day08 then is O(n log n + K log n).
+     *
+     *      aoc::ClosestPairs pairs(points);
+     *      for (const aoc::PointPair& p : pairs) { ... break; }
+     */
+    class ClosestPairs {
+        using Candidate = std::pair<int64_t, uint32_t>;     // dist, j
+
+        struct Cursor {
+            int64_t radius{-1};                 // rings scanned
+            int64_t bound2{0};                  // candidates closer than this are certain
+            bool complete{false};               // all cells scanned
+            std::vector<Candidate> heap;        // min-heap
+        };
+
+        std::vector<Point3> points_;
+        Point3 min_{};
+        int64_t cell_{1};
+        std::array<int64_t, 3> dims_{};
+        std::vector<uint32_t> cellStart_;       // points of cell c: cellPoints_[cellStart_[c]..cellStart_[c+1])
+        std::vector<uint32_t> cellPoints_;
+        std::vector<Cursor> cursors_;
+        std::vector<PointPair> heap_;           // min-heap of the certain heads
+
+        void init();
+        [[nodiscard]] std::array<int64_t, 3> cell_of(const Point3& p) const noexcept;
+        void scan_ring(uint32_t i);
+        bool make_certain(uint32_t i);
+        void push_head(uint32_t i);
+
+    public:
+        template <std::ranges::input_range R> requires Point3Like<std::ranges::range_value_t<R>>
+        explicit ClosestPairs(R&& points) {
+            for (const auto& p : points)
+                points_.push_back(Point3{static_cast<int64_t>(p.x), static_cast<int64_t>(p.y), static_cast<int64_t>(p.z)});
+            init();
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return points_.size(); }
+
+        // the next closest pair, none after the last one
+        std::optional<PointPair> next();
+
+        class iterator {
+            ClosestPairs* pairs_{nullptr};
+            std::optional<PointPair> current_;
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using difference_type  = std::ptrdiff_t;
+            using value_type       = PointPair;
+
+            iterator() = default;
+            explicit iterator(ClosestPairs* pairs) : pairs_(pairs), current_(pairs->next()) {}
+
+            const PointPair& operator*() const noexcept { return *current_; }
+            iterator& operator++() { current_ = pairs_->next(); return *this; }
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return !it.current_; }
+        };
+
+        // single pass, begin() takes the next pair
+        iterator begin() { return iterator(this); }
+        [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+    };
+}
+
+#endif // AOC_POINTS
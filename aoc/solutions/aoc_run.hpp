@@ -0,0 +1,33 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_RUN
+#define AOC_RUN
+
+#include "aoc_uses.hpp"
+
+namespace aoc {
+
+    /*
+     * What is known about the current run, collected on the way for the benchmark
+     * record (see record): the day and example from println, the input size from Input.
+     */
+    struct RunInfo {
+        int day{0};
+        int example{-1};
+        size_t inputBytes{0};
+        size_t elements{0};                 // for counters per element, 0: the input lines
+        std::function<size_t()> inputLines; // set by Input::of, counted only when asked for
+
+        [[nodiscard]] size_t element_count() const {
+            if (elements > 0) return elements;
+            return inputLines ? inputLines() : 0;
+        }
+    };
+
+    inline RunInfo& run_info() {
+        static RunInfo info;
+        return info;
+    }
+}
+
+#endif // AOC_RUN
@@ -0,0 +1,132 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_SCAN
+#define AOC_SCAN
+
+#include "aoc_uses.hpp"
+
+namespace aoc {
+
+    /*
+     * A string literal as template argument, e.g. scan<"{}-{}">. The format is only
+     * known to the compiler, so it can be taken apart at compile time.
+     */
+    template <size_t N>
+    struct fixed_string {
+        char chars[N]{};
+
+        consteval fixed_string(const char (&s)[N]) { std::copy_n(s, N, chars); }
+
+        [[nodiscard]] constexpr string_view view() const noexcept { return {chars, N - 1}; }
+    };
+
+    namespace scan_detail {
+
+        // a format "a{}b{}" is split into the literals "a", "b" and "" around its fields
+        struct Literal {
+            size_t pos;
+            size_t len;
+        };
+
+        template <fixed_string Fmt>
+        consteval size_t field_count() {
+            size_t count = 0;
+            for (size_t pos = Fmt.view().find("{}"); pos != string_view::npos; pos = Fmt.view().find("{}", pos + 2))
+                ++count;
+            return count;
+        }
+
+        template <fixed_string Fmt>
+        consteval auto literals() {
+            std::array<Literal, field_count<Fmt>() + 1> result{};
+            size_t from = 0;
+            for (size_t i = 0; i + 1 < result.size(); ++i) {
+                const size_t pos = Fmt.view().find("{}", from);
+                result[i] = {from, pos - from};
+                from = pos + 2;
+            }
+            result.back() = {from, Fmt.view().size() - from};
+            return result;
+        }
+
+        template <size_t>
+        using Int64 = int64_t;
+
+        template <typename T>
+        concept Scannable = std::same_as<T, char> || std::same_as<T, string_view>
+                         || ((std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>);
+
+        // reads one field at pos; a string_view field ends before the next literal
+        template <Scannable T>
+        constexpr bool read(const string_view line, size_t& pos, T& value, const string_view next) noexcept {
+            const char* first = line.data() + pos;
+            const char* const last = line.data() + line.size();
+
+            if constexpr (std::same_as<T, char>) {
+                if (first == last) return false;
+                value = *first;
+                ++pos;
+                return true;
+            } else if constexpr (std::same_as<T, string_view>) {
+                const size_t end = next.empty() ? line.size() : line.find(next.front(), pos);
+                if (end == string_view::npos) return false;
+                value = line.substr(pos, end - pos);
+                pos = end;
+                return true;
+            } else {
+                if (first != last && *first == '+') ++first;     // from_chars does not like '+'
+                const auto [p, ec] = std::from_chars(first, last, value);
+                pos = static_cast<size_t>(p - line.data());
+                return ec == std::errc();
+            }
+        }
+
+        template <fixed_string Fmt, Scannable... Ts>
+        constexpr std::optional<std::tuple<Ts...>> scan(const string_view line) noexcept {
+            constexpr auto lits = literals<Fmt>();
+            static_assert(sizeof...(Ts) + 1 == lits.size(), "aoc::scan: number of types and fields differ");
+
+            auto literal = [](const size_t i) constexpr {
+                return Fmt.view().substr(literals<Fmt>()[i].pos, literals<Fmt>()[i].len);
+            };
+            auto matchLiteral = [&](const size_t i, size_t& pos) {
+                if (!line.substr(pos).starts_with(literal(i))) return false;
+                pos += literal(i).size();
+                return true;
+            };
+
+            std::tuple<Ts...> values{};
+            size_t pos = 0;
+            const bool ok = [&]<size_t... I>(std::index_sequence<I...>) {
+                return matchLiteral(0, pos)
+                    && ((read(line, pos, std::get<I>(values), literal(I + 1)) && matchLiteral(I + 1, pos)) && ...);
+            }(std::index_sequence_for<Ts...>{});
+
+            if (!ok || pos != line.size())
+                return std::nullopt;
+            return values;
+        }
+    }
+
+    /*
+     * Parses a line against a format like "{}-{}" in one pass, the fields go into a
+     * tuple, by default of int64_t. Fields can be integers, floating points, a char
+     * (exactly one) or a string_view (up to the next literal). No exceptions, no
+     * allocation: if the line does not match completely, the result is empty.
+     *
+     *      if (const auto r = aoc::scan<"{}-{}">("3-5")) ... // r = tuple{3,5}
+     *      aoc::scan<"{}{}", char, int64_t>("L68")            // tuple{'L',68}
+     */
+    template <fixed_string Fmt, scan_detail::Scannable... Ts>
+    constexpr auto scan(const string_view line) noexcept {
+        if constexpr (sizeof...(Ts) == 0) {
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                return scan_detail::scan<Fmt, scan_detail::Int64<I>...>(line);
+            }(std::make_index_sequence<scan_detail::field_count<Fmt>()>{});
+        } else {
+            return scan_detail::scan<Fmt, Ts...>(line);
+        }
+    }
+}
+
+#endif // AOC_SCAN
@@ -4,10 +4,13 @@
 #define AOC_SOLUTION
 
 #include "aoc_uses.hpp"
+#include "aoc_run.hpp"
 
 namespace aoc {
 
     inline void println(int day, int example) {
+        run_info().day = day;
+        run_info().example = example;
         auto data = (example==-1) ? "input" : format("example {}", example);
         auto info = format("day {} | {}", day, data);
         std::println("{}\n{}", info, string(info.size(), '='));
@@ -16,32 +19,180 @@ namespace aoc {
     struct solutions {
         int64_t part1;
         int64_t part2;
+
+        bool operator==(const solutions&) const noexcept = default;
+    };
+
+    /*
+     * Keeps the compiler from dropping a value it can see is unused, or from moving
+     * the computation out of a timing loop; do_not_optimize(x) 'reads' x, clobber_memory()
+     * 'writes' all memory.
+     */
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /*
+     * Hardware counters (environment AOC_PERF=1), summed over all timed runs. Linux
+     * only, via perf_event_open; if the kernel does not allow it (e.g. in a container
+     * or with perf_event_paranoid > 2), valid stays false and nothing is printed.
+     * Counters the cpu does not have stay 0.
+     * Counted are the calling thread and the workers of all thread pools alive at the
+     * start (ThreadPool::shared() is started for this), so par_fold and the like are
+     * included; threads of their own, e.g. the bands of par_generations, are not.
+     */
+    struct Counters {
+        bool valid{false};
+        size_t threads{0};                  // counted threads
+        uint64_t cycles{0};
+        uint64_t instructions{0};
+        uint64_t l1dMisses{0};
+        uint64_t llcMisses{0};
+        uint64_t branchMisses{0};
+    };
+
+    // one group of counters per thread, started and stopped around each run; see aoc.cpp
+    class PerfCounters {
+        static constexpr size_t events = 5;
+        std::vector<std::array<int, events>> groups_;
+        Counters total_;
+
+    public:
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        void start();
+        void stop();
+        [[nodiscard]] const Counters& total() const noexcept { return total_; }
+    };
+
+    /*
+     * Result of a measurement. By default one run, then ms is its time and the rest
+     * is the same or 0. In benchmark mode (environment AOC_BENCH=n, optional
+     * AOC_BENCH_WARMUP=w, default n/10 but at least 1) there are w untimed warm-up
+     * runs and n timed ones, and ms is the minimum, i.e. the least disturbed run.
+     */
+    struct Timing {
+        double ms{0};
+        size_t runs{1};
+        double median{0};
+        double p99{0};
+        double mean{0};
+        double stddev{0};
+        Counters counters;
+    };
+
+    // see aoc.cpp
+    struct BenchConfig {
+        size_t runs{0};                     // 0: no benchmark mode, one run
+        size_t warmup{0};
+        bool counters{false};
     };
+    const BenchConfig& bench_config();
+    Timing timing_of(std::vector<double> samples);
 
     template <typename F>
     auto measure(F&& f) {
         using R = std::invoke_result_t<F&>; // actual return type of f()
+        using clock = std::chrono::steady_clock;
+
+        const auto& config = bench_config();
+        std::optional<PerfCounters> perf;
+        if (config.counters)
+            perf.emplace();
 
-        const auto start = std::chrono::high_resolution_clock::now();
-        if constexpr (std::is_void_v<R>) {
-            std::forward<F>(f)();               // call for void
-            auto end = std::chrono::high_resolution_clock::now();
-            double ms = std::chrono::duration<double, std::milli>(end - start).count();
-            return std::pair {std::monostate{}, ms};
-        } else {
-            R result = std::forward<F>(f)();    // call with result
-            auto end = std::chrono::high_resolution_clock::now();
-            double ms = std::chrono::duration<double, std::milli>(end - start).count();
-            return std::pair<R, double>{std::move(result), ms};
-        }
+        auto once = [&](std::vector<double>* samples) {
+            if (samples && perf) perf->start();
+            clobber_memory();
+            const auto start = clock::now();
+            if constexpr (std::is_void_v<R>) {
+                f();                            // call for void
+                clobber_memory();
+                const auto end = clock::now();
+                if (samples && perf) perf->stop();
+                if (samples) samples->push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                return std::monostate{};
+            } else {
+                R result = f();                 // call with result
+                do_not_optimize(result);
+                const auto end = clock::now();
+                if (samples && perf) perf->stop();
+                if (samples) samples->push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                return result;
+            }
+        };
+
+        std::vector<double> samples;
+        samples.reserve(std::max<size_t>(config.runs, 1));
+        for (size_t i = 0; i < config.warmup; ++i)
+            once(nullptr);
+        for (size_t i = 1; i < config.runs; ++i)
+            once(&samples);
+        auto result = once(&samples);       // the last one is returned
+        auto timing = timing_of(std::move(samples));
+        if (perf)
+            timing.counters = perf->total();
+        return std::pair<decltype(result), Timing>{std::move(result), timing};
     }
 
+    // peak resident set size of this process in KiB, 0 if unknown; see aoc.cpp
+    size_t peak_rss_kib();
+
     inline void println(const solutions &answer, double ms) {
         std::println("-> {:.2f} ms", ms);
         std::println("-> part 1: {}", answer.part1);
         std::println("-> part 2: {}", answer.part2);
     }
 
+    /*
+     * With AOC_RECORD=file in the environment, appends one record of this run to
+     * file: day, answers, timing, input size and git revision. A file ending in
+     * '.csv' gets CSV (with a header if new), anything else JSON lines; see aoc.cpp.
+     */
+    void record(const solutions &answer, const Timing& timing);
+
+    // ipc and misses per run and element, e.g. ' | ipc 2.10 | per line: L1d 0.52, LLC 0.01, br 0.30'
+    inline string format_counters(const Timing& timing) {
+        const auto& c = timing.counters;
+        if (!c.valid)
+            return {};
+        const size_t elements = run_info().element_count();
+        const auto perElement = static_cast<double>(timing.runs * std::max<size_t>(elements, 1));
+        auto per = [&](const uint64_t n) { return static_cast<double>(n) / perElement; };
+        const double ipc = (c.cycles > 0) ? static_cast<double>(c.instructions) / static_cast<double>(c.cycles) : 0.0;
+        return format(" | ipc {:.2f} | per {}: L1d {:.2f}, LLC {:.2f}, br {:.2f} | {} thread{}",
+                      ipc, elements > 0 ? "element" : "run", per(c.l1dMisses), per(c.llcMisses), per(c.branchMisses),
+                      c.threads, c.threads == 1 ? "" : "s");
+    }
+
+    inline void println(const solutions &answer, const Timing& timing) {
+        record(answer, timing);
+        if (timing.runs > 1)
+            std::println("-> {:.2f} ms min, {:.2f} median, {:.2f} p99, {:.2f} stddev ({} runs){}",
+                         timing.ms, timing.median, timing.p99, timing.stddev, timing.runs, format_counters(timing));
+        else
+            std::println("-> {:.2f} ms{}", timing.ms, format_counters(timing));
+        std::println("-> part 1: {}", answer.part1);
+        std::println("-> part 2: {}", answer.part2);
+    }
+
 }
 
 #endif // AOC_SOLUTION
@@ -0,0 +1,175 @@
+// (C) A.Voß, a.voss@fh-aachen.de, info@codebasedlearning.dev
+
+#ifndef AOC_SPARSE
+#define AOC_SPARSE
+
+#include "aoc_uses.hpp"
+#include "aoc_field.hpp"
+#include "aoc_flat.hpp"
+
+namespace aoc {
+
+    /*
+     * An unbounded grid for huge or mostly empty coordinate ranges, negative ones
+     * included. Cells live in dense chunks of 2^ChunkBits x 2^ChunkBits (64 x 64 by
+     * default), found by their chunk coordinate in a FlatMap. A chunk is allocated on
+     * the first write into it; reading a cell of a missing chunk gives the background
+     * value. Same operator[] and halo as Field, every position is valid.
+     * Chunks are never moved (a deque), so references to cells stay valid, but a
+     * write through the non-const operator[] may allocate.
+     */
+    template <typename T, unsigned ChunkBits = 6>
+    class SparseField {
+    public:
+        using value_type = T;
+        static constexpr index_t chunk_size = index_t{1} << ChunkBits;
+
+        struct Chunk {
+            RC origin;                                          // the cell at local (0,0)
+            std::array<T, chunk_size * chunk_size> cells;
+
+            T& operator[](const index_t row, const index_t col) noexcept { return cells[row * chunk_size + col]; }
+            const T& operator[](const index_t row, const index_t col) const noexcept { return cells[row * chunk_size + col]; }
+        };
+
+    private:
+        static constexpr index_t mask = chunk_size - 1;
+
+        T background_;
+        std::deque<Chunk> chunks_;
+        FlatMap<RC, index_t> index_;                            // chunk coordinate -> chunk
+
+        // >> rounds down for negative coordinates, too
+        static RC chunk_of(const RC rc) noexcept { return {rc.row >> ChunkBits, rc.col >> ChunkBits}; }
+
+        [[nodiscard]] const Chunk* find_chunk(const RC rc) const noexcept {
+            const auto it = index_.find(chunk_of(rc));
+            return it == index_.end() ? nullptr : &chunks_[static_cast<size_t>((*it).second)];
+        }
+
+        Chunk& chunk_at(const RC rc) {
+            const RC key = chunk_of(rc);
+            auto [it, isNew] = index_.try_emplace(key, static_cast<index_t>(chunks_.size()));
+            if (isNew) {
+                chunks_.emplace_back();
+                chunks_.back().origin = {key.row << ChunkBits, key.col << ChunkBits};
+                chunks_.back().cells.fill(background_);
+            }
+            return chunks_[static_cast<size_t>((*it).second)];
+        }
+
+    public:
+        explicit SparseField(const T& background = T{}) : background_(background) {}
+
+        [[nodiscard]] const T& background() const noexcept { return background_; }
+        [[nodiscard]] size_t chunks() const noexcept { return chunks_.size(); }
+        [[nodiscard]] size_t bytes() const noexcept { return chunks_.size() * sizeof(Chunk); }
+
+        // unbounded, for Halo
+        [[nodiscard]] static constexpr bool isValid(const RC) noexcept { return true; }
+
+        [[nodiscard]] bool allocated(const RC rc) const noexcept { return find_chunk(rc) != nullptr; }
+
+        const T& operator[](const RC& rc) const noexcept {
+            const Chunk* c = find_chunk(rc);
+            return c ? (*c)[rc.row & mask, rc.col & mask] : background_;
+        }
+        const T& operator[](const index_t row, const index_t col) const noexcept { return (*this)[RC{row, col}]; }
+
+        // allocates the chunk of rc if needed
+        T& operator[](const RC& rc) { return chunk_at(rc)[rc.row & mask, rc.col & mask]; }
+        T& operator[](const index_t row, const index_t col) { return (*this)[RC{row, col}]; }
+
+        // the chunks in the order of allocation, e.g. for a chunk-local pass
+        [[nodiscard]] const std::deque<Chunk>& chunk_list() const noexcept { return chunks_; }
+        std::deque<Chunk>& chunk_list() noexcept { return chunks_; }
+
+        // the smallest rectangle around all chunks, {first, last} inclusive; empty: {0,0},{-1,-1}
+        [[nodiscard]] std::pair<RC, RC> bounds() const noexcept {
+            if (chunks_.empty()) return {RC{0, 0}, RC{-1, -1}};
+            RC first = chunks_.front().origin, last = first;
+            for (const auto& c : chunks_) {
+                first = {std::min(first.row, c.origin.row), std::min(first.col, c.origin.col)};
+                last = {std::max(last.row, c.origin.row), std::max(last.col, c.origin.col)};
+            }
+            return {first, last + RC{mask, mask}};
+        }
+    };
+
+    /*
+     * Calls f(value) or f(rc, value) for all cells of the allocated chunks, chunk by
+     * chunk, row by row within a chunk, i.e. along the memory.
+     */
+    template <typename T, unsigned B, typename F>
+    void for_each_cell(const SparseField<T, B>& field, F&& f) {
+        constexpr index_t n = SparseField<T, B>::chunk_size;
+        for (const auto& chunk : field.chunk_list()) {
+            for (index_t row = 0; row < n; ++row) {
+                for (index_t col = 0; col < n; ++col) {
+                    if constexpr (std::invocable<F&, const T&>)
+                        f(chunk[row, col]);
+                    else
+                        f(chunk.origin + RC{row, col}, chunk[row, col]);
+                }
+            }
+        }
+    }
+
+    template <typename T, unsigned B, typename F>
+    void for_each_cell(SparseField<T, B>& field, F&& f) {
+        constexpr index_t n = SparseField<T, B>::chunk_size;
+        for (auto& chunk : field.chunk_list()) {
+            for (index_t row = 0; row < n; ++row) {
+                for (index_t col = 0; col < n; ++col) {
+                    if constexpr (std::invocable<F&, T&>)
+                        f(chunk[row, col]);
+                    else
+                        f(chunk.origin + RC{row, col}, chunk[row, col]);
+                }
+            }
+        }
+    }
+
+    /*
+     * Counts the neighbors of rc with pred(value). Inside a chunk this is direct
+     * access, only cells on the chunk border look up the neighboring chunks.
+     */
+    template <typename Neighborhood, typename T, unsigned B, typename Pred>
+    index_t count_neighbors(const SparseField<T, B>& field, const RC rc, Pred&& pred) {
+        constexpr index_t n = SparseField<T, B>::chunk_size;
+        constexpr index_t reach = std::ranges::max(Neighborhood::offsets | std::views::transform(
+            [](const RC o) { return std::max({o.row, -o.row, o.col, -o.col}); }));
+
+        const RC local{rc.row & (n - 1), rc.col & (n - 1)};
+        const bool inner = local.row >= reach && local.row < n - reach && local.col >= reach && local.col < n - reach;
+        index_t count = 0;
+        if (inner) {
+            if (!field.allocated(rc))           // all neighbors are background, too
+                return pred(field.background()) ? static_cast<index_t>(Neighborhood::offsets.size()) : 0;
+            const T* const center = &field[rc];
+            for (const RC o : Neighborhood::offsets)
+                count += pred(center[o.row * n + o.col]) ? 1 : 0;
+        } else {
+            for (const RC o : Neighborhood::offsets)
+                count += pred(field[rc + o]) ? 1 : 0;
+        }
+        return count;
+    }
+
+    template <typename T, unsigned B>
+    auto halo_plus(const SparseField<T, B>& f, RC center) {
+        return Halo<T, VonNeumannNeighborhood, SparseField<T, B>>(f, center);
+    }
+
+    template <typename T, unsigned B>
+    auto halo_cross(const SparseField<T, B>& f, RC center) {
+        return Halo<T, DiagonalsNeighborhood, SparseField<T, B>>(f, center);
+    }
+
+    template <typename T, unsigned B>
+    auto halo(const SparseField<T, B>& f, RC center) {
+        return Halo<T, MooreNeighborhood, SparseField<T, B>>(f, center);
+    }
+}
+
+#endif // AOC_SPARSE
@@ -15,10 +15,19 @@
 #include <algorithm>
 #include <ranges>
 #include <memory>
+#include <new>
 #include <vector>
+#include <deque>
+#include <list>
 #include <array>
+#include <span>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
 #include <iterator>
 #include <cstddef>
+#include <bit>
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 #include <regex>
@@ -27,8 +36,21 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <optional>
+#include <tuple>
 #include <functional>
+#include <numeric>
+#include <random>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <barrier>
+#include <latch>
+#include <atomic>
+#include <exception>
 #include <cstdlib>
+#include <cstring>
 #include <utility>
 #include <cassert>
 #include <cmath>
@@ -34,7 +34,7 @@ struct DirectionSteps {
 
     static DirectionSteps of(const string_view term) {
         // a little bit overengineered, I wanted to have a reg-ex with groups (as template)
-        // or use from_chars
+        // or use from_chars - aoc::scan is both
         // static const std::regex re(R"(^([LR])(\d+)$)");
         //
         // std::smatch m;
@@ -44,17 +44,12 @@ struct DirectionSteps {
         // const Turn turn = m[1].str()=="L" ? Turn::Left : Turn::Right;
         // return { turn, aoc::to_number<int64_t>(m[2].str()) };
 
-        if (term.size() < 2)
-            throw std::runtime_error(format("term too short: '{}'", term));
-        const char dir = term.front();
-        if (dir != 'L' && dir != 'R')
-            throw std::runtime_error(format("invalid direction: '{}'", term));
-
-        const auto first = term.data() + 1;
-        const auto last  = term.data() + term.size();
-        const auto turn = (dir == 'L') ? Turn::Left : Turn::Right;
-        const auto steps = aoc::to_number<int64_t>(string_view{first, last});
-        return { turn, steps };
+        if (const auto r = aoc::scan<"{}{}", char, int64_t>(term)) {
+            const auto [dir, steps] = *r;
+            if (dir == 'L' || dir == 'R')
+                return { (dir == 'L') ? Turn::Left : Turn::Right, steps };
+        }
+        throw std::runtime_error(format("format does not match, term='{}'", term));
     }
 };
 
@@ -93,9 +88,11 @@ int main() {
 
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
+    // in constant memory, for inputs larger than RAM:
+    //      auto lines = aoc::LineStream::of(day) | aoc::first_block_view;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines); });
+    aoc::println(answer, timing);
 
     // 1055 (3), 6386 (6)
     if constexpr (example==-1) { assert(answer.part1==1055 && answer.part2==6386); } // best 0.06ms
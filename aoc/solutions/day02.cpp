@@ -21,13 +21,9 @@ struct IdPair {
     int64_t id2;
 
     static IdPair of(const string_view term) {
-        const auto pos = term.find('-');
-        if (pos == string_view::npos)
-            throw std::runtime_error(format("format does not match, term='{}'", term));
-
-        const auto id1 = aoc::to_number<int64_t>(term.substr(0, pos));
-        const auto id2 = aoc::to_number<int64_t>(term.substr(pos + 1));
-        return {id1, id2};
+        if (const auto ids = aoc::scan<"{}-{}">(term))
+            return std::make_from_tuple<IdPair>(*ids);
+        throw std::runtime_error(format("format does not match, term='{}'", term));
     }
 };
 
@@ -65,28 +61,28 @@ std::vector<IdPair> to_idPairs(std::ranges::input_range auto&& lines) {
     // }
 }
 
-using DivSet = std::unordered_set<size_t>;
-
-const DivSet& quotients(size_t n) {
-    static std::unordered_map<size_t, DivSet> cache{ {1,DivSet()} };
+// the proper divisors (block lengths) of n; a vector, no node per divisor
+using DivSet = std::vector<size_t>;
 
-    if (n <= 1) n=1;
-    if (const auto it = cache.find(n); it != cache.end())
-        return it->second;
+DivSet properDivisors(const size_t n) {
+    if (n <= 1)
+        return {};
 
     DivSet result{1};
     const auto limit = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
     for (size_t d = 2; d <= limit; ++d) {
         if (n % d == 0) {
-            result.emplace(d);
-            result.emplace(n / d);
+            result.push_back(d);
+            if (d != n / d)
+                result.push_back(n / d);
         }
     }
-
-    auto [it, _] = cache.emplace(n, std::move(result));
-    return it->second;
+    return result;
 }
 
+// n is a digit count, so the lookup is an array index (and thread-safe)
+aoc::memo<size_t, DivSet> quotients{properDivisors, {.dense = 64}};
+
 bool checkInvalidIdPart1(const string_view sv) {
     const size_t n = sv.size();
     if (n % 2 != 0)
@@ -107,9 +103,8 @@ bool checkInvalidIdPart2(const string_view sv) {
     });
 }
 
-aoc::solutions solve(std::ranges::input_range auto&& lines) {
-    auto idPairs = to_idPairs(lines);
-
+// one id after the other, as string
+aoc::solutions solveByBruteForce(const std::vector<IdPair>& idPairs) {
     int64_t sum1 = 0;
     int64_t sum2 = 0;
     for (const auto [id1, id2] : idPairs) {
@@ -122,10 +117,112 @@ aoc::solutions solve(std::ranges::input_range auto&& lines) {
                 sum2 += id;
         }
     }
-
     return {sum1, sum2};
 }
 
+// 19-digit ids (>= 10^18) overflow int64_t in 10^len, the repunits and the sums, so these are done in 128 bits
+using Wide = unsigned __int128;
+
+constexpr Wide pow10(const size_t n) {
+    Wide p = 1;
+    for (size_t i = 0; i < n; ++i) p *= 10;
+    return p;
+}
+
+constexpr size_t digitsOf(int64_t id) {
+    size_t n = 1;
+    while (id >= 10) { id /= 10; ++n; }
+    return n;
+}
+
+/*
+ * The sum of all ids in [lo,hi] with len digits that are a block of q digits repeated
+ * (q divides len). Such an id is block * repunit, with repunit = 10..010..01 (len/q
+ * ones), so it is just the sum over an interval of blocks, no id has to be visited.
+ */
+Wide sumRepeated(const Wide lo, const Wide hi, const size_t len, const size_t q) {
+    const Wide repunit = (pow10(len) - 1) / (pow10(q) - 1);
+    const Wide first = std::max(pow10(q - 1), (lo + repunit - 1) / repunit);
+    const Wide last = std::min(pow10(q) - 1, hi / repunit);
+    if (first > last)
+        return 0;
+    return repunit * ((first + last) * (last - first + 1) / 2);
+}
+
+/*
+ * The same, but only ids whose shortest block has q digits. An id with block q also
+ * has all blocks d that repeat into q, and the shortest of them divides q; so the
+ * ids of the shorter blocks (divisors of q) are taken out again, inclusion–exclusion.
+ */
+Wide sumPrimitive(const Wide lo, const Wide hi, const size_t len, const size_t q) {
+    Wide sum = sumRepeated(lo, hi, len, q);
+    for (const size_t d : quotients(q))
+        sum -= sumPrimitive(lo, hi, len, d);
+    return sum;
+}
+
+// only the invalid ids, class by class (digit count, block length); independent of the range width
+aoc::solutions solveByEnumeration(const std::vector<IdPair>& idPairs) {
+    Wide sum1 = 0;
+    Wide sum2 = 0;
+    for (const auto [id1, id2] : idPairs) {
+        for (size_t len = digitsOf(id1); len <= digitsOf(id2); ++len) {
+            const Wide lo = std::max(static_cast<Wide>(id1), pow10(len - 1));
+            const Wide hi = std::min(static_cast<Wide>(id2), pow10(len) - 1);
+            if (len % 2 == 0)
+                sum1 += sumRepeated(lo, hi, len, len / 2);
+            for (const size_t q : quotients(len))           // each id counted with its shortest block only
+                sum2 += sumPrimitive(lo, hi, len, q);
+        }
+    }
+    return {static_cast<int64_t>(sum1), static_cast<int64_t>(sum2)};
+}
+
+// some ranges of up to 10^4 ids with up to 19 digits, to check the enumeration against the brute force
+std::vector<IdPair> randomIdPairs(const size_t count) {
+    constexpr uint64_t maxWidth = 10'000;
+    std::mt19937_64 random{2025};
+    std::vector<IdPair> idPairs;
+    for (size_t i = 0; i < count; ++i) {
+        const auto first = static_cast<uint64_t>(pow10(random() % 19));       // 1 to 19 digits
+        const uint64_t span = std::min<uint64_t>(9 * first, std::numeric_limits<int64_t>::max() - first - maxWidth);
+        const auto lo = static_cast<int64_t>(first + random() % span);
+        idPairs.push_back({lo, lo + static_cast<int64_t>(random() % maxWidth)});
+    }
+    idPairs.push_back({999'999'999'999'900'000, 1'000'000'000'000'100'000});        // 18 to 19 digits
+    idPairs.push_back({1'111'111'111'111'100'000, 1'111'111'111'111'200'000});      // 19 ones
+    return idPairs;
+}
+
+enum class Strategy { BruteForce, Enumeration };
+
+aoc::solutions solve(std::ranges::input_range auto&& lines, const Strategy strategy) {
+    const auto idPairs = to_idPairs(lines);
+    switch (strategy) {
+        case Strategy::BruteForce:  return solveByBruteForce(idPairs);
+        case Strategy::Enumeration: return solveByEnumeration(idPairs);
+    }
+    throw std::runtime_error("unknown strategy");
+}
+
+// the same divisors from a small, bounded memo, used by several threads at once; keys beyond a
+// dense range, so all of them go through the shards and most get dropped and computed again
+bool checkBoundedMemo() {
+    constexpr size_t capacity = 8, shards = 4, keys = 1000, rounds = 4;
+    aoc::memo<size_t, DivSet> bounded{properDivisors, {.capacity = capacity, .shards = shards}};
+    std::atomic<bool> ok{true};
+    aoc::ThreadPool pool(4);
+    pool.run(pool.size(), [&](const size_t t) {
+        for (size_t i = 0; i < rounds * keys; ++i) {
+            const size_t n = (i * 7 + t * 131) % keys + 1;
+            if (bounded.get(n) != properDivisors(n) || bounded.size() > capacity)
+                ok = false;
+        }
+    });
+    try { (void)bounded(1); ok = false; } catch (const std::runtime_error&) {}    // no references with a capacity
+    return ok;
+}
+
 int main() {
     println("\n--- {} ---\n", __FILE__);
 
@@ -136,8 +233,15 @@ int main() {
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines, Strategy::Enumeration); });
+    aoc::println(answer, timing);
+
+    // the brute force is the reference, for the input and for random ranges
+    assert(answer == solve(lines, Strategy::BruteForce));
+    assert(std::ranges::all_of(randomIdPairs(200), [](const IdPair& idPair) {
+        return solveByEnumeration({idPair}) == solveByBruteForce({idPair});
+    }));
+    assert(checkBoundedMemo());
 
     // 24157613387 (1227775554), 33832678380 (4174379265)
     if constexpr (example==-1) { assert(answer.part1==24157613387 && answer.part2==33832678380); } // best 64ms
@@ -51,6 +51,23 @@ aoc::solutions solve(std::ranges::input_range auto&& lines) {
     return {sum1, sum2};
 }
 
+/*
+ * The lines are independent, so they can be folded in parallel. For the real input
+ * (200 lines) this is the loop above, as the parts would be too small.
+ */
+aoc::solutions solveParallel(std::ranges::random_access_range auto&& lines) {
+    return lines | aoc::par_fold(aoc::solutions{0, 0},
+        [](const aoc::solutions& a, const aoc::solutions& b) { return aoc::solutions{a.part1 + b.part1, a.part2 + b.part2}; },
+        [](const string_view line) { return aoc::solutions{calcJoltage(line, 2), calcJoltage(line, 12)}; });
+}
+
+// parallel needs random access, so a single-pass LineStream only works with the plain loop
+template <bool Parallel>
+aoc::solutions solveWith(std::ranges::input_range auto&& lines) {
+    if constexpr (Parallel) return solveParallel(lines);
+    else return solve(lines);
+}
+
 int main() {
     println("\n--- {} ---\n", __FILE__);
 
@@ -60,9 +77,12 @@ int main() {
 
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
+    // in constant memory, for inputs larger than RAM (with useParallel = false):
+    //      auto lines = aoc::LineStream::of(day) | aoc::first_block_view;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    constexpr bool useParallel = true;
+    auto [answer, timing] = aoc::measure([&] { return solveWith<useParallel>(lines); });
+    aoc::println(answer, timing);
 
     // 17144 (357), 170371185255900 (3121910778619)
     if constexpr (example==-1) { assert(answer.part1==17144 && answer.part2==170371185255900); } // 0.05ms
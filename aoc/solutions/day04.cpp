@@ -23,29 +23,34 @@ R"(
     };
 }
 
-aoc::solutions solve(std::ranges::input_range auto&& lines) {
-    auto field = lines | aoc::to_field<char>;
+// flat: no node and no allocation per entry (was std::unordered_set)
+using RCSet = aoc::FlatSet<aoc::RC>;
+
+// round by round, only the remaining papers are checked
+aoc::solutions solveBySets(std::ranges::input_range auto&& lines) {
+    // with a border of '.', each neighbor is just a fixed offset, no bounds checks
+    auto field = lines | aoc::to_padded_field('.');
 
     int64_t sum1{0};
     int64_t sum2{0};
 
     // collect all positions
-    auto papers = std::ranges::to<std::unordered_set<aoc::RC>>(
+    auto papers = std::ranges::to<RCSet>(
         positions(field)
         | std::views::filter([&](const aoc::RC rc) { return field[rc] == '@'; })
     );
 
+    // the same as
+    //      std::ranges::count_if(halo(field, rc), [&](const aoc::RC cell) { return field[cell] == '@'; });
     auto neighbor_count = [&](const aoc::RC rc) {
-        return std::ranges::count_if( halo(field, rc),
-            [&](const aoc::RC cell) { return field[cell] == '@'; }
-        );
+        return aoc::count_neighbors<aoc::MooreNeighborhood>(field, rc, [](const char c) { return c == '@'; });
     };
 
     // abort if too long
     for (size_t loop=0; loop<1000; ++loop) {
 
         // reduce papers
-        auto toLift = std::ranges::to<std::unordered_set<aoc::RC>>(
+        auto toLift = std::ranges::to<RCSet>(
             papers
             | std::views::filter([&](const aoc::RC rc) { return neighbor_count(rc) < 4; })
         );
@@ -64,6 +69,100 @@ aoc::solutions solve(std::ranges::input_range auto&& lines) {
     return {sum1, sum2};
 }
 
+// round by round, one stencil pass over the whole field marks the papers to lift
+aoc::solutions solveByStencil(std::ranges::input_range auto&& lines) {
+    auto field = lines | aoc::to_padded_field('.');
+
+    int64_t sum1{0};
+    int64_t sum2{0};
+
+    // abort if too long
+    for (size_t loop=0; loop<1000; ++loop) {
+        const auto toLift = aoc::stencil<aoc::MooreNeighborhood>(field, [](const char c, const auto& neighbors) {
+            return static_cast<uint8_t>(c == '@' && std::ranges::count(neighbors, '@') < 4);
+        });
+
+        int64_t lifted{0};
+        aoc::for_each_cell(field, [&](const aoc::RC rc, char& cell) {
+            if (toLift[rc]) {
+                cell = '.';
+                ++lifted;
+            }
+        });
+
+        if (loop==0) { sum1 = lifted; }
+        sum2 += lifted;
+
+        if (lifted==0)
+            break;
+    }
+    return {sum1, sum2};
+}
+
+// round by round, one bit per cell and 64 neighbor counts at once
+aoc::solutions solveByBits(std::ranges::input_range auto&& lines) {
+    aoc::BitField papers = aoc::to_bit_field(lines | aoc::to_field<char>, [](const char c) { return c == '@'; });
+
+    int64_t sum1{0};
+    int64_t sum2{0};
+
+    // abort if too long
+    for (size_t loop=0; loop<1000; ++loop) {
+        const auto toLift = papers & papers.neighbors_below<aoc::MooreNeighborhood>(4);
+        const auto lifted = static_cast<int64_t>(toLift.count());
+
+        if (loop==0) { sum1 = lifted; }
+        sum2 += lifted;
+
+        if (lifted==0)
+            break;
+        papers.remove(toLift);
+    }
+    return {sum1, sum2};
+}
+
+// a worklist, only the neighbors of lifted papers are recounted; the order does not matter
+aoc::solutions solveByPeeling(std::ranges::input_range auto&& lines) {
+    auto field = lines | aoc::to_padded_field('.');
+    const auto [firstWave, total] = aoc::peel<aoc::MooreNeighborhood>(field, [](const char c) { return c == '@'; }, 4, '.');
+    return {firstWave, total};
+}
+
+// round by round as with the stencil, but in place on row bands in parallel
+aoc::solutions solveByGenerations(std::ranges::input_range auto&& lines) {
+    auto field = lines | aoc::to_padded_field('.');
+
+    auto lift = [](const char c, const auto& neighbors) {
+        return (c == '@' && std::ranges::count(neighbors, '@') < 4) ? '.' : c;
+    };
+    auto papers = [&] {
+        int64_t count{0};
+        aoc::for_each_cell(field, [&](const char c) { count += (c == '@'); });
+        return count;
+    };
+
+    const auto initial = papers();
+    aoc::par_generations<aoc::MooreNeighborhood>(field, lift, 1);
+    const auto afterFirst = papers();
+    // in chunks, until a call stops early, i.e. a generation changed nothing (papers are only removed, so it does)
+    constexpr size_t chunk = 1000;
+    while (aoc::par_generations<aoc::MooreNeighborhood>(field, lift, chunk) == chunk) {}
+    return {initial - afterFirst, initial - papers()};
+}
+
+enum class Strategy { Sets, Stencil, Bits, Peeling, Generations };
+
+aoc::solutions solve(std::ranges::input_range auto&& lines, const Strategy strategy) {
+    switch (strategy) {
+        case Strategy::Sets:    return solveBySets(lines);
+        case Strategy::Stencil: return solveByStencil(lines);
+        case Strategy::Bits:    return solveByBits(lines);
+        case Strategy::Peeling: return solveByPeeling(lines);
+        case Strategy::Generations: return solveByGenerations(lines);
+    }
+    throw std::runtime_error("unknown strategy");
+}
+
 int main() {
     println("\n--- {} ---\n", __FILE__);
 
@@ -74,8 +173,8 @@ int main() {
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines, Strategy::Peeling); });
+    aoc::println(answer, timing);
 
     // 1578 (13), 10132 (43)
     if constexpr (example==-1) { assert(answer.part1==1578 && answer.part2==10132); } // 2.81ms
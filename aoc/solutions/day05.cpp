@@ -35,14 +35,9 @@ struct Range {
         // slow:
         //      static const std::regex re(R"(^(\d+)-(\d+)$)"); // without spaces, positive only
         //      std::smatch match;
-        const auto pos = line.find('-');
-        if (pos == std::string_view::npos)
-            throw std::runtime_error("bad format");
-
-        return {
-            aoc::to_number<int64_t>(line.substr(0, pos)),
-            aoc::to_number<int64_t>(line.substr(pos + 1))
-        };
+        if (const auto fromTo = aoc::scan<"{}-{}">(line))
+            return std::make_from_tuple<Range>(*fromTo);
+        throw std::runtime_error("bad format");
     }
 };
 
@@ -97,11 +92,15 @@ aoc::solutions solve(std::ranges::input_range auto&& rangeLines, std::ranges::in
         | std::views::transform([](const auto &s){ return aoc::to_number<int64_t>(s); });
 
     // here is still a little potential as both can be sorted before
-    int64_t sum1 = 0;
-    for (auto id : ids) {
-        sum1 += std::ranges::any_of(ranges,
-                                    [&](const Range& r){ return r.contains(id); }) ? 1 : 0; // '?' not needed (bool cast)
-    }
+    //      int64_t sum1 = 0;
+    //      for (auto id : ids) {
+    //          sum1 += std::ranges::any_of(ranges,
+    //                                      [&](const Range& r){ return r.contains(id); }) ? 1 : 0; // '?' not needed (bool cast)
+    //      }
+
+    // the ids are independent, so fold them in parallel (sequential for small inputs)
+    auto sum1 = ids | aoc::par_fold(int64_t{0}, std::plus{},
+        [&](const int64_t id) -> int64_t { return std::ranges::any_of(ranges, [&](const Range& r){ return r.contains(id); }); });
 
     // classical
     //      int64_t sum2 = 0;
@@ -135,8 +134,8 @@ int main() {
     auto rangeLines = *blocks.begin();
     auto idLines = *(++blocks.begin());
 
-    auto [answer, ms] = aoc::measure([&] { return solve(rangeLines,idLines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(rangeLines,idLines); });
+    aoc::println(answer, timing);
 
     // 529 (3), 344260049617193 (14)
     if constexpr (example==-1) { assert(answer.part1==529 && answer.part2==344260049617193); } // 0.06ms
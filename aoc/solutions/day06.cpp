@@ -17,21 +17,6 @@ R"(
     };
 }
 
-struct transpose_fn {
-    auto operator()(const aoc::Field<char>& field) const -> std::vector<std::string> {
-        std::vector lines(field.cols(), string(field.rows(), ' '));
-        for (aoc::index_t row = 0; row < field.rows(); ++row)
-            for (aoc::index_t col = 0; col < field.cols(); ++col)
-                lines[col][row] = field[row,col];
-        return lines;
-    }
-
-    friend auto operator|(const aoc::Field<char>& f, transpose_fn fn) -> std::vector<std::string> {
-        return fn(f);
-    }
-};
-inline constexpr transpose_fn to_transposed{};
-
 using BinOp = int64_t(*)(int64_t, int64_t);
 constexpr int64_t add(int64_t a, int64_t b) { return a + b; }
 constexpr int64_t mul(int64_t a, int64_t b) { return a * b; }
@@ -63,23 +48,28 @@ aoc::solutions solve(std::ranges::input_range auto&& mathLines, const string_vie
         );
     }
 
-    // converting to field seems not optimal, but it also normalizes the lines
-    auto colNumbers = mathLines | aoc::to_field<char> | to_transposed;
-    colNumbers.push_back(""); // row continues across ops; each op consumes one column block, this forces the final op
+    // converting to field seems not optimal, but it also normalizes the lines;
+    // the numbers are then read top-down from the columns of a view, no strings
+    const auto chars = mathLines | aoc::to_field<char>;
+    const auto view = chars.view();
 
     int64_t sum2 = 0;
-    size_t row = 0;
+    aoc::index_t col = 0;
     for (auto &op: ops) {
         int64_t res = op.start;
-        while (row < colNumbers.size()) {
-            auto line = aoc::trim(colNumbers[row]);
-            row++;
-            if (line.empty()) {
-                sum2 += res;
-                break;
+        for (; col < view.cols(); ++col) {
+            int64_t number = 0;
+            bool digits = false;
+            for (const char c : view.col(col)) {
+                if (c < '0' || c > '9') continue;
+                number = number * 10 + (c - '0');
+                digits = true;
             }
-            res = op.binOp(res, aoc::to_number<int64_t>(line));
+            if (!digits) break;         // an empty column ends the block of an op
+            res = op.binOp(res, number);
         }
+        ++col;
+        sum2 += res;
     }
 
     return {sum1,sum2};
@@ -119,8 +109,8 @@ int main() {
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto [lines, operations] = input | aoc::as_std_lines | split_last_line;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines, operations); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines, operations); });
+    aoc::println(answer, timing);
 
     // 5346286649122 (4277556), 10389131401929 (3263827)
     if constexpr (example==-1) { assert(answer.part1==5346286649122 && answer.part2==10389131401929); } // 0.43
@@ -41,31 +41,10 @@ R"(
 struct Box {
     int64_t x, y, z;
 
-    static Box of(const string_view line, const char delim = ',') {
-        // assume 'x,y,z'
-        const auto p1 = line.find(delim);
-        const auto p2 = line.find(delim, p1 + 1);
-        return {
-            aoc::to_number<int64_t>(line.substr(0, p1)),
-            aoc::to_number<int64_t>(line.substr(p1 + 1, p2 - (p1 + 1))),
-            aoc::to_number<int64_t>(line.substr(p2 + 1))
-        };
-    }
-};
-
-struct BoxPair {
-    size_t i{}, j{};
-    int64_t dist{};
-
-    static int64_t norm2(const Box& b1, const Box& b2) {
-        const int64_t dx = b1.x - b2.x;
-        const int64_t dy = b1.y - b2.y;
-        const int64_t dz = b1.z - b2.z;
-        return (dx*dx + dy*dy + dz*dz); // std::sqrt is not necessary for ordering
-    }
-
-    static BoxPair of(const size_t i, const Box& b1, const size_t j, const Box& b2) {
-        return BoxPair{i,j,norm2(b1,b2)};
+    static Box of(const string_view line) {
+        if (const auto xyz = aoc::scan<"{},{},{}">(line))
+            return std::make_from_tuple<Box>(*xyz);
+        throw std::runtime_error(format("format does not match, line='{}'", line));
     }
 };
 
@@ -111,25 +90,13 @@ struct Nodes {
     }
 };
 
-aoc::solutions solve(const size_t maxProcessedPart1, std::ranges::input_range auto&& lines, const bool useDSU) {
-    auto boxes = lines
-            | std::views::transform([](const string_view sv) { return Box::of(sv); })
-            | std::ranges::to<std::vector>();
-
-    std::vector<BoxPair> pairs;
-    pairs.reserve(boxes.size()*(boxes.size()-1)/2);
-    for (size_t i = 0; i < boxes.size(); ++i) {
-        for (size_t j = i+1; j < boxes.size(); ++j) {
-            pairs.emplace_back(BoxPair::of(i, boxes[i], j, boxes[j]));
-        }
-    }
-
-    std::ranges::sort(pairs,[](const BoxPair& a, const BoxPair& b) { return (a.dist < b.dist); });
-
+// takes the pairs closest first, until all boxes are in one circuit
+aoc::solutions connect(const std::vector<Box>& boxes, std::ranges::input_range auto&& pairs,
+                       const size_t maxProcessedPart1, const bool useDSU) {
     int64_t sum1 = 1;
     int64_t sum2 = 0;
 
-    BoxPair lastPairPart2;
+    std::ranges::range_value_t<decltype(pairs)> lastPairPart2{};
     size_t processedPart1 = 0;
 
     if (useDSU) {
@@ -200,6 +167,49 @@ aoc::solutions solve(const size_t maxProcessedPart1, std::ranges::input_range au
     return {sum1,sum2};
 }
 
+// SortAll: generate and sort all pairs (in parallel), Closest: only as many as needed, lazily
+enum class Strategy { SortAll, Closest };
+
+std::vector<Box> to_boxes(std::ranges::input_range auto&& lines) {
+    return lines
+            | std::views::transform([](const string_view sv) { return Box::of(sv); })
+            | std::ranges::to<std::vector>();
+}
+
+aoc::solutions solve(const size_t maxProcessedPart1, std::ranges::input_range auto&& lines, const bool useDSU, const Strategy strategy) {
+    const auto boxes = to_boxes(lines);
+
+    switch (strategy) {
+        case Strategy::SortAll: return connect(boxes, aoc::sorted_pairs(boxes), maxProcessedPart1, useDSU);
+        case Strategy::Closest: return connect(boxes, aoc::ClosestPairs(boxes), maxProcessedPart1, useDSU);
+    }
+    throw std::runtime_error("unknown strategy");
+}
+
+// the lazy pairs are all pairs, in the order of the sorted ones, i.e. by (dist, i, j)
+bool sameAsSorted(const std::vector<Box>& boxes) {
+    return std::ranges::equal(aoc::ClosestPairs(boxes), aoc::sorted_pairs(boxes));
+}
+
+// no, one and two boxes, ties (few coordinates), flat ones, boxes on a line, spread and clustered ones
+std::vector<std::vector<Box>> randomBoxSets() {
+    std::mt19937_64 random{2025};
+    const auto boxes = [&](const size_t n, const int64_t range, const bool flatY, const bool flatZ) {
+        std::vector<Box> result(n);
+        for (auto& [x, y, z] : result) {
+            x = static_cast<int64_t>(random() % range);
+            y = flatY ? 0 : static_cast<int64_t>(random() % range);
+            z = flatZ ? 0 : static_cast<int64_t>(random() % range);
+        }
+        return result;
+    };
+    auto clustered = boxes(200, 100'000, false, false);
+    std::ranges::copy(boxes(100, 10, false, false), std::back_inserter(clustered));
+    return {boxes(0, 10, false, false), boxes(1, 10, false, false), boxes(2, 10, false, false),
+            boxes(300, 4, false, false), boxes(300, 1000, false, true), boxes(200, 1000, true, true),
+            boxes(200, 20, true, true), boxes(500, 100'000, false, false), clustered};
+}
+
 int main() {
     println("\n--- {} ---\n", __FILE__);
 
@@ -212,8 +222,12 @@ int main() {
     constexpr size_t maxProcessedPart1 = (example==-1) ? 1000 : 10;
 
     // DSU: useDSU = true, Nodes: false
-    auto [answer, ms] = aoc::measure([&] { return solve(maxProcessedPart1,lines, true); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(maxProcessedPart1,lines, true, Strategy::Closest); });
+    aoc::println(answer, timing);
+
+    // the sorted pairs are the reference, for the input and for random boxes
+    assert(sameAsSorted(to_boxes(lines)));
+    assert(std::ranges::all_of(randomBoxSets(), sameAsSorted));
 
     // 84968 (40), 8663467782 (25272)
     if constexpr (example==-1) { assert(answer.part1==84968 && answer.part2==8663467782); } // nodes 26.64ms, dsu 23.16ms
@@ -23,13 +23,16 @@ R"(
 
 aoc::RC toRC(const string_view line) {
     // special version: col first
-    const auto p = line.find(',');
-    return {
-        aoc::to_number<int64_t>(line.substr(p + 1)),
-        aoc::to_number<int64_t>(line.substr(0, p))
-    };
+    if (const auto cr = aoc::scan<"{},{}">(line)) {
+        const auto [col, row] = *cr;
+        return {row, col};
+    }
+    throw std::runtime_error(format("format does not match, line='{}'", line));
 }
 
+// point-in-polygon results, flat: no node and no allocation per entry (was std::unordered_map)
+using PipCache = aoc::FlatMap<aoc::RC, bool>;
+
 struct Rect {
     int64_t r1, c1, r2, c2;
 
@@ -114,11 +117,11 @@ struct OrthoEdges {
     }
 
     // cached version
-    bool containsPointCached(const aoc::RC &rc, std::unordered_map<aoc::RC,bool> &cache) const {
-        if (const auto it = cache.find(rc); it != cache.end()) return it->second;
+    bool containsPointCached(const aoc::RC &rc, PipCache &cache) const {
+        if (const auto it = cache.find(rc); it != cache.end()) return (*it).second;
 
         bool inside = containsPoint(rc);
-        cache.emplace(rc, inside);
+        cache.try_emplace(rc, inside);
         return inside;
     }
 
@@ -129,7 +132,7 @@ struct OrthoEdges {
      *  - Require all 4 corners inside-or-on-boundary
      *  - Require no proper cuts
      */
-    bool containsRectCached(const Rect &rect, std::unordered_map<aoc::RC,bool> &cache) const {
+    bool containsRectCached(const Rect &rect, PipCache &cache) const {
         const int64_t rMin = std::min(rect.r1, rect.r2);
         const int64_t rMax = std::max(rect.r1, rect.r2);
         const int64_t cMin = std::min(rect.c1, rect.c2);
@@ -191,7 +194,7 @@ aoc::solutions solve(std::ranges::input_range auto&& lines) {
 
     auto edges = OrthoEdges::of(poly);
 
-    std::unordered_map<aoc::RC, bool> pipCache;
+    PipCache pipCache;
     pipCache.reserve(poly.size() * poly.size() / 2);
 
     int64_t sum1 = 0;
@@ -222,8 +225,8 @@ int main() {
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines); });
+    aoc::println(answer, timing);
 
     // 4725826296 (50), 1637556834 (24)
     if constexpr (example==-1) { assert(answer.part1==4725826296 && answer.part2==1637556834); } // 15.59ms
@@ -31,8 +31,8 @@ int main() {
     const auto input = (example >= 0) ? aoc::Input::of(examples[example]) : aoc::Input::of(day);
     auto lines = input | aoc::as_std_lines;
 
-    auto [answer, ms] = aoc::measure([&] { return solve(lines); });
-    aoc::println(answer, ms);
+    auto [answer, timing] = aoc::measure([&] { return solve(lines); });
+    aoc::println(answer, timing);
 
     // 1 (1), 2 (2)
     if constexpr (example==-1) { assert(answer.part1==1 && answer.part2==2); }